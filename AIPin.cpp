@@ -14,7 +14,9 @@
 #include <Arduino.h>
 
 #include <AIPin.h>
+#define RC_MODULE RC_MODULE_IO
 #include <rc_debug_lib.h>
+#include <rc_adc.h>
 
 
 namespace rc
@@ -41,6 +43,9 @@ void AIPin::setPin(uint8_t p_pin)
 	
 	m_pin = p_pin;
 	pinMode(p_pin, INPUT);
+#ifdef RC_USE_ADC
+	adc::enable(p_pin);
+#endif
 }
 
 
@@ -143,43 +148,52 @@ void AIPin::setCalibration(uint16_t p_min, uint16_t p_center, uint16_t p_max)
 
 int16_t AIPin::read() const
 {
-	uint16_t raw = analogRead(m_pin);
+#ifdef RC_USE_ADC
+	if (adc::isRunning() && adc::isReady(m_pin) == false)
+	{
+		// the first oversampled value isn't there yet, 0 would be full deflection
+		return m_destination != Input_None ? rc::getInput(m_destination) : 0;
+	}
+	
+	// the sampler has more resolution, scale the calibration up to match
+	uint8_t  bits = adc::isRunning() ? RC_ADC_OVERSAMPLING : 0;
+	uint16_t raw  = adc::isRunning() ? adc::read(m_pin) : analogRead(m_pin);
+#else
+	uint8_t  bits = 0;
+	uint16_t raw  = analogRead(m_pin);
+#endif
+	uint16_t center  = m_center << bits;
+	uint16_t minimum = m_min << bits;
+	uint16_t maximum = m_max << bits;
 	
 	// reverse if needed
-	if (m_reversed) raw = 1023 - raw;
+	if (m_reversed) raw = (1023 << bits) - raw;
 	
 	// apply trim
-	raw += m_trim;
+	raw += m_trim * (1 << bits);
 	
 	// early abort
-	if (raw <= m_min) return writeInputValue(-256);
-	if (raw >= m_max) return writeInputValue( 256);
+	if (raw <= minimum) return writeInputValue(-256);
+	if (raw >= maximum) return writeInputValue( 256);
 	
 	// calculate distance from center and maximum distance from center
-	uint16_t out = raw > m_center ?   raw - m_center : m_center -   raw;
-	uint16_t max = raw > m_center ? m_max - m_center : m_center - m_min;
+	uint16_t out = raw > center ?     raw - center : center -     raw;
+	uint16_t max = raw > center ? maximum - center : center - minimum;
 	
 	// change the range from [0 - max] to [0 - 256]
 	
-	// first bring the value down to below 256, or we'll be getting overflows, we'll compensate later
-	int bits = 0;
-	while (out >= 256)
+	// first bring both down to below 256, or we'll be getting overflows,
+	// out is smaller than max so the ratio is all we need
+	while (max >= 256)
 	{
 		out >>= 1;
-		++bits;
+		max >>= 1;
 	}
 	
 	out <<= 8;  // multiply by 256
 	out /= max; // bring down to new range
 	
-	// bring the value back up if we did any truncating before
-	while (bits > 0)
-	{
-		out <<= 1;
-		--bits;
-	}
-	
-	return writeInputValue((raw < m_center) ? -out : out);
+	return writeInputValue((raw < center) ? -out : out);
 }
 
 
@@ -101,7 +101,13 @@ public:
 	void setCalibration(uint16_t p_min, uint16_t p_center, uint16_t p_max);
 	
 	/*! \brief Reads and processes.
-	    \return Processed value, range [-256 - 256].*/
+	    \return Processed value, range [-256 - 256].
+	    \note While the ADC sampler of rc_adc.h is running this returns its latest, oversampled value
+	           of the pin right away instead of waiting for analogRead. The pin is added to the sampler
+	           by setPin when RC_USE_ADC is defined. Until the sampler has a value for the pin the last
+	           value written to the destination is held (center without a destination), analogRead
+	           can't be used while the sampler is running. Read once before adc::start() to hold the
+	           actual stick position instead of center.*/
 	int16_t read() const;
 	
 private:
@@ -14,7 +14,9 @@
 #include <Arduino.h>
 
 #include <AIPinCalibrator.h>
+#define RC_MODULE RC_MODULE_IO
 #include <rc_debug_lib.h>
+#include <rc_tick.h>
 
 
 namespace rc
@@ -90,7 +92,7 @@ void AIPinCalibrator::update()
 		{
 			// initial value of the center
 			m_center = (m_min + m_max) / 2;
-			m_start  = static_cast<uint16_t>(millis());
+			m_start  = rc::tick::getMillis();
 		}
 		
 		// make sure a min and max are set and that they're far enough apart
@@ -106,14 +108,14 @@ void AIPinCalibrator::update()
 			m_start = 0;
 		}
 		RC_TRACE("Raw: %u Min: %u Max: %u Center: %u Delta: %u",
-			raw, m_min, m_max, m_center, m_start == 0 ? 0 : static_cast<uint16_t>(millis()) - m_start);
+			raw, m_min, m_max, m_center, m_start == 0 ? 0 : rc::tick::getMillis() - m_start);
 	}
 }
 
 
 bool AIPinCalibrator::isDone() const
 {
-	return m_active && m_start != 0 && ((static_cast<uint16_t>(millis()) - m_start) >= Center_Time);
+	return m_active && m_start != 0 && (static_cast<uint16_t>(rc::tick::getMillis() - m_start) >= Center_Time);
 }
 
 
@@ -14,7 +14,9 @@
 #include <Arduino.h>
 
 #include <AnalogSwitch.h>
+#define RC_MODULE RC_MODULE_SWITCH
 #include <rc_debug_lib.h>
+#include <rc_tick.h>
 #include <util.h>
 
 
@@ -90,7 +92,7 @@ int16_t AnalogSwitch::update(SwitchState p_state)
 		return writeInputValue(0);
 	}
 	
-	uint16_t now = static_cast<uint16_t>(millis());
+	uint16_t now = rc::tick::getMillis();
 	uint16_t delta = now - m_lastTime;
 	m_lastTime = now;
 	
@@ -13,6 +13,7 @@
 
 #include <Arduino.h>
 
+#define RC_MODULE RC_MODULE_IO
 #include <rc_debug_lib.h>
 #include <Buzzer.h>
 #include <Timer2.h>
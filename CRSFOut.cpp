@@ -0,0 +1,199 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** CRSFOut.cpp
+** CRSF Output functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#include <CRSFOut.h>
+#include <outputchannel.h>
+#define RC_MODULE RC_MODULE_PPM
+#include <rc_debug_lib.h>
+#include <rc_uartint.h>
+#include <util.h>
+
+
+namespace rc
+{
+
+enum
+{
+	CRSF_ADDRESS   = 0xEE, //!< Transmitter module
+	CRSF_TYPE_RC   = 0x16, //!< RC channels packed
+	CRSF_RC_LENGTH = 24    //!< Type, 22 bytes of channels and CRC
+};
+
+// CRC8 with polynomial 0xD5 (DVB-S2) for every byte value
+static const uint8_t s_crcTable[256] PROGMEM =
+{
+	0x00, 0xD5, 0x7F, 0xAA, 0xFE, 0x2B, 0x81, 0x54, 0x29, 0xFC, 0x56, 0x83, 0xD7, 0x02, 0xA8, 0x7D,
+	0x52, 0x87, 0x2D, 0xF8, 0xAC, 0x79, 0xD3, 0x06, 0x7B, 0xAE, 0x04, 0xD1, 0x85, 0x50, 0xFA, 0x2F,
+	0xA4, 0x71, 0xDB, 0x0E, 0x5A, 0x8F, 0x25, 0xF0, 0x8D, 0x58, 0xF2, 0x27, 0x73, 0xA6, 0x0C, 0xD9,
+	0xF6, 0x23, 0x89, 0x5C, 0x08, 0xDD, 0x77, 0xA2, 0xDF, 0x0A, 0xA0, 0x75, 0x21, 0xF4, 0x5E, 0x8B,
+	0x9D, 0x48, 0xE2, 0x37, 0x63, 0xB6, 0x1C, 0xC9, 0xB4, 0x61, 0xCB, 0x1E, 0x4A, 0x9F, 0x35, 0xE0,
+	0xCF, 0x1A, 0xB0, 0x65, 0x31, 0xE4, 0x4E, 0x9B, 0xE6, 0x33, 0x99, 0x4C, 0x18, 0xCD, 0x67, 0xB2,
+	0x39, 0xEC, 0x46, 0x93, 0xC7, 0x12, 0xB8, 0x6D, 0x10, 0xC5, 0x6F, 0xBA, 0xEE, 0x3B, 0x91, 0x44,
+	0x6B, 0xBE, 0x14, 0xC1, 0x95, 0x40, 0xEA, 0x3F, 0x42, 0x97, 0x3D, 0xE8, 0xBC, 0x69, 0xC3, 0x16,
+	0xEF, 0x3A, 0x90, 0x45, 0x11, 0xC4, 0x6E, 0xBB, 0xC6, 0x13, 0xB9, 0x6C, 0x38, 0xED, 0x47, 0x92,
+	0xBD, 0x68, 0xC2, 0x17, 0x43, 0x96, 0x3C, 0xE9, 0x94, 0x41, 0xEB, 0x3E, 0x6A, 0xBF, 0x15, 0xC0,
+	0x4B, 0x9E, 0x34, 0xE1, 0xB5, 0x60, 0xCA, 0x1F, 0x62, 0xB7, 0x1D, 0xC8, 0x9C, 0x49, 0xE3, 0x36,
+	0x19, 0xCC, 0x66, 0xB3, 0xE7, 0x32, 0x98, 0x4D, 0x30, 0xE5, 0x4F, 0x9A, 0xCE, 0x1B, 0xB1, 0x64,
+	0x72, 0xA7, 0x0D, 0xD8, 0x8C, 0x59, 0xF3, 0x26, 0x5B, 0x8E, 0x24, 0xF1, 0xA5, 0x70, 0xDA, 0x0F,
+	0x20, 0xF5, 0x5F, 0x8A, 0xDE, 0x0B, 0xA1, 0x74, 0x09, 0xDC, 0x76, 0xA3, 0xF7, 0x22, 0x88, 0x5D,
+	0xD6, 0x03, 0xA9, 0x7C, 0x28, 0xFD, 0x57, 0x82, 0xFF, 0x2A, 0x80, 0x55, 0x01, 0xD4, 0x7E, 0xAB,
+	0x84, 0x51, 0xFB, 0x2E, 0x7A, 0xAF, 0x05, 0xD0, 0xAD, 0x78, 0xD2, 0x07, 0x53, 0x86, 0x2C, 0xF9
+};
+
+
+// Public functions
+
+CRSFOut::CRSFOut()
+:
+m_idx(PacketSize),
+m_rate(150),
+m_interval(1000000UL / 150),
+m_nextTime(0)
+{
+	
+}
+
+
+void CRSFOut::start(uint32_t p_baud)
+{
+	RC_TRACE("start baud: %lu", p_baud);
+	
+#ifdef RC_USE_UART
+	uartint::setTxHandler(CRSFOut::isr, this);
+#endif
+	
+	// 8 data bits, no parity, 1 stop bit, double speed for the best match at high rates
+	uint16_t ubrr = ((F_CPU / 8) + (p_baud / 2)) / p_baud - 1;
+	UCSR0A = _BV(U2X0);
+	UBRR0H = (ubrr >> 8) & 0x0F;
+	UBRR0L = ubrr & 0xFF;
+	UCSR0C = _BV(UCSZ01) | _BV(UCSZ00);
+	UCSR0B |= _BV(TXEN0);
+	
+	// first packet goes out on the next update
+	m_idx = PacketSize;
+	m_nextTime = micros();
+}
+
+
+void CRSFOut::stop()
+{
+	RC_TRACE("stop");
+	
+	// the transmitter finishes the byte it's sending before it stops
+	uint8_t oldSREG = SREG;
+	cli();
+	UCSR0B &= ~(_BV(TXEN0) | _BV(UDRIE0));
+	m_idx = PacketSize;
+	SREG = oldSREG;
+	
+#ifdef RC_USE_UART
+	uartint::setTxHandler(0);
+#endif
+}
+
+
+void CRSFOut::setRate(uint16_t p_rate)
+{
+	RC_TRACE("set rate: %u Hz", p_rate);
+	RC_ASSERT_MINMAX(p_rate, 1, 1000);
+	
+	m_rate = p_rate;
+	m_interval = 1000000UL / p_rate;
+}
+
+
+uint16_t CRSFOut::getRate() const
+{
+	return m_rate;
+}
+
+
+bool CRSFOut::update()
+{
+	if (m_idx < PacketSize || (UCSR0B & _BV(TXEN0)) == 0)
+	{
+		// still sending, or stopped
+		return false;
+	}
+	
+	uint32_t now = micros();
+	if (static_cast<int32_t>(now - m_nextTime) < 0)
+	{
+		return false;
+	}
+	
+	// keep the schedule, unless we're so late that a whole packet has been missed
+	m_nextTime += m_interval;
+	if (static_cast<int32_t>(now - m_nextTime) >= 0)
+	{
+		m_nextTime = now + m_interval;
+	}
+	
+	m_packet[0] = CRSF_ADDRESS;
+	m_packet[1] = CRSF_RC_LENGTH;
+	m_packet[2] = CRSF_TYPE_RC;
+	microsToPacked(getRawOutputChannels(), Channels < RC_MAX_CHANNELS ? Channels : RC_MAX_CHANNELS, m_packet + 3);
+	m_packet[PacketSize - 1] = crc8(m_packet + 2, PacketSize - 3);
+	
+	// the interrupt routine takes it from here
+	m_idx = 0;
+	uint8_t oldSREG = SREG;
+	cli();
+	UCSR0B |= _BV(UDRIE0);
+	SREG = oldSREG;
+	return true;
+}
+
+
+void CRSFOut::dataRegisterEmpty()
+{
+	if (m_idx < PacketSize)
+	{
+		UDR0 = m_packet[m_idx];
+		++m_idx;
+	}
+	if (m_idx >= PacketSize)
+	{
+		// the last byte is on its way, nothing more to send
+		UCSR0B &= ~_BV(UDRIE0);
+	}
+}
+
+
+uint8_t CRSFOut::crc8(const uint8_t* p_data, uint8_t p_length)
+{
+	uint8_t crc = 0;
+	for (uint8_t i = 0; i < p_length; ++i)
+	{
+		crc = pgm_read_byte(&s_crcTable[crc ^ p_data[i]]);
+	}
+	return crc;
+}
+
+
+// Private functions
+
+#ifdef RC_USE_UART
+void CRSFOut::isr(void* p_user)
+{
+	reinterpret_cast<CRSFOut*>(p_user)->dataRegisterEmpty();
+}
+#endif // RC_USE_UART
+
+
+// namespace end
+}
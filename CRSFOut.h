@@ -0,0 +1,102 @@
+#ifndef INC_RC_CRSFOUT_H
+#define INC_RC_CRSFOUT_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** CRSFOut.h
+** CRSF Output functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <rc_config.h>
+
+
+namespace rc
+{
+
+/*! 
+ *  \brief     Class to encapsulate CRSF Output functionality.
+ *  \details   This class sends the first 16 output channels as CRSF RC channel packets to a transmitter module,
+ *             like the ones used by Crossfire and ExpressLRS, at a fixed packet rate.
+ *             A packet is 26 bytes, it's sent by the UART from a buffer, one interrupt per byte.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ *  \warning   The UART can't be used by Serial at the same time.
+ *  \note      A 16 MHz part can't make the usual 416666 baud, use 400000 (the default) and
+ *             a module which detects or can be set to that rate.
+ */
+class CRSFOut
+{
+public:
+	/*! \brief Constructs a CRSFOut object.*/
+	CRSFOut();
+	
+	/*! \brief Sets up the UART for CRSF.
+	    \param p_baud Baud rate, 8 data bits, no parity, 1 stop bit.
+	    \note Enables the transmitter, the first packet is sent by the next call to update().
+	    \note Uses the data register empty interrupt handler if RC_USE_UART is defined.*/
+	void start(uint32_t p_baud = 400000);
+	
+	/*! \brief Stops sending, the byte being sent is finished.*/
+	void stop();
+	
+	/*! \brief Sets the packet rate.
+	    \param p_rate Packets per second, range [1 - 1000], default 150.
+	    \note A packet takes 650 microseconds to send at 400000 baud.*/
+	void setRate(uint16_t p_rate);
+	
+	/*! \brief Gets the packet rate.
+	    \return Packets per second.*/
+	uint16_t getRate() const;
+	
+	/*! \brief Starts sending a packet with the current output channels if the next packet is due.
+	    \return Whether a packet has been started.
+	    \note Packets keep to their schedule, a late update() delays one packet but not the ones after it.
+	          When a whole packet has been missed the schedule starts again from now.
+	    \note Channels are read only when a packet is started, call this often.*/
+	bool update();
+	
+	/*! \brief Sends the next byte of the packet.
+	    \note Call this from your USART_UDRE interrupt handler if you're handling interrupts yourself.*/
+	void dataRegisterEmpty();
+	
+	/*! \brief Calculates the CRC8 used by CRSF, polynomial 0xD5.
+	    \param p_data Data to calculate the CRC over.
+	    \param p_length Number of bytes in p_data.
+	    \return The CRC.*/
+	static uint8_t crc8(const uint8_t* p_data, uint8_t p_length);
+	
+private:
+	enum
+	{
+		PacketSize = 26, //!< Address, length, type, 22 bytes of channels and CRC.
+		Channels   = 16  //!< Number of channels in a packet.
+	};
+	
+#ifdef RC_USE_UART
+	static void isr(void* p_user);
+#endif
+	
+	uint8_t          m_packet[PacketSize]; //!< Packet being sent.
+	volatile uint8_t m_idx;                //!< Next byte to send, PacketSize when done.
+	uint16_t         m_rate;               //!< Packets per second.
+	uint32_t         m_interval;           //!< Time between packets in microseconds.
+	uint32_t         m_nextTime;           //!< Time at which the next packet is due in microseconds.
+};
+/** \example crsfout_example.pde
+ * This is an example of how to use the CRSFOut class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_CRSFOUT_H
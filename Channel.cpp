@@ -14,7 +14,9 @@
 #include <Arduino.h>
 
 #include <Channel.h>
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
+#include <rc_tick.h>
 #include <util.h>
 
 
@@ -99,7 +101,7 @@ void Channel::setSpeed(uint8_t p_speed)
 	RC_TRACE("set speed: %u", p_speed);
 	RC_ASSERT_MINMAX(p_speed, 0, 100);
 	m_speed = p_speed;
-	m_time  = static_cast<uint8_t>(millis());
+	m_time  = rc::tick::getMillis();
 }
 
 
@@ -153,15 +155,18 @@ int16_t Channel::applySpeed(int16_t p_target)
 {
 	// we use 0xFFFF as an indicator that applySpeed has never been called yet
 	// in that case we want to set the servo position immediately to the requested position
+	uint16_t now = rc::tick::getMillis();
 	if (m_speed == 0 || p_target == m_last || m_last == int16_t(0xFFFF))
 	{
+		// keep the time as well, or a servo which has been standing still would jump when it starts moving
 		m_last = p_target;
+		m_time = now;
 		return p_target;
 	}
-	// we might as well use 8 bit for times, just make sure to update at least 4 times per second
-	// (1000 ms / 256 = 3.9 overflows per second)
-	uint8_t now = static_cast<uint8_t>(millis());
-	uint8_t delta = now - m_time;
+	// the calculation below uses 8 bit for the delta, a servo that hasn't been updated
+	// for more than a quarter of a second only moves as far as it would in 255 ms
+	uint16_t elapsed = now - m_time;
+	uint8_t delta = elapsed > 255 ? 255 : static_cast<uint8_t>(elapsed);
 	
 	// the total amount traveled in the past delta time is:
 	// (full throw / time which it takes to travel) * delta time
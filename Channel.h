@@ -104,7 +104,7 @@ private:
 	uint8_t  m_epMax;    //!< End point maximum
 	int8_t   m_subtrim;  //!< Subtrim
 	uint8_t  m_speed;    //!< Servo speed
-	uint8_t  m_time;     //!< Last time update was called
+	uint16_t m_time;     //!< Last time applySpeed was called in milliseconds
 	int16_t  m_last;     //!< Value of last update
 };
 /** \example channel_example.pde
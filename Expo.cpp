@@ -12,6 +12,7 @@
 ** -------------------------------------------------------------------------*/
 
 #include <Expo.h>
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
 
 
@@ -34,7 +35,20 @@ static const uint8_t s_expoNeg[EXPO_POINTS] = {101, 128, 147, 161, 174, 185, 194
 Expo::Expo(int8_t p_expo, Input p_index)
 :
 InputModifier(p_index),
-m_expo(p_expo)
+m_expo(p_expo),
+m_tableExpo(0),
+m_table(0)
+{
+	
+}
+
+
+Expo::Expo(const Expo& p_rhs)
+:
+InputModifier(p_rhs.m_index),
+m_expo(p_rhs.m_expo),
+m_tableExpo(0),
+m_table(0)
 {
 	
 }
@@ -46,6 +60,7 @@ void Expo::set(int8_t p_expo)
 	RC_ASSERT_MINMAX(p_expo, -100, 100);
 	
 	m_expo = p_expo;
+	buildTable();
 }
 
 
@@ -55,11 +70,19 @@ int8_t Expo::get() const
 }
 
 
+void Expo::setTable(uint8_t* p_table)
+{
+	m_table = p_table;
+	buildTable(true);
+}
+
+
 Expo& Expo::operator = (int8_t p_rhs)
 {
 	RC_ASSERT_MINMAX(p_rhs, -100, 100);
 	
 	m_expo = p_rhs;
+	buildTable();
 	return *this;
 }
 
@@ -68,6 +91,7 @@ Expo& Expo::operator = (const Expo& p_rhs)
 {
 	m_expo  = p_rhs.m_expo;
 	m_index = p_rhs.m_index;
+	buildTable();
 	return *this;
 }
 
@@ -94,6 +118,34 @@ int16_t Expo::apply(int16_t p_value) const
 {
 	RC_ASSERT_MINMAX(p_value, -256, 256);
 	
+	// the table is only valid if the expo hasn't been modified through a pointer
+	if (m_table == 0 || m_tableExpo != m_expo)
+	{
+		return calculate(p_value);
+	}
+	
+	// full deflection is not in the table, it's always 256
+	if (p_value < 0)
+	{
+		return p_value == -256 ? -256 : -static_cast<int16_t>(m_table[-p_value]);
+	}
+	return p_value == 256 ? 256 : static_cast<int16_t>(m_table[p_value]);
+}
+
+
+void Expo::apply() const
+{
+	if (m_index != Input_None)
+	{
+		rc::setInput(m_index, apply(rc::getInput(m_index)));
+	}
+}
+
+
+// Private functions
+
+int16_t Expo::calculate(int16_t p_value) const
+{
 	if (m_expo == 0)
 	{
 		// early abort
@@ -137,12 +189,19 @@ int16_t Expo::apply(int16_t p_value) const
 }
 
 
-void Expo::apply() const
+void Expo::buildTable(bool p_force)
 {
-	if (m_index != Input_None)
+	if (m_table == 0 || (m_tableExpo == m_expo && p_force == false))
 	{
-		rc::setInput(m_index, apply(rc::getInput(m_index)));
+		return;
+	}
+	
+	// output never exceeds 255 for input [0 - 255], so it fits in a byte
+	for (int16_t i = 0; i < TableSize; ++i)
+	{
+		m_table[i] = static_cast<uint8_t>(calculate(i));
 	}
+	m_tableExpo = m_expo;
 }
 
 
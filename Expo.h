@@ -25,6 +25,8 @@ namespace rc
 /*! 
  *  \brief     Class to encapsulate Expo functionality.
  *  \details   This class provides exponential transformation.
+ *             Optionally a buffer can be supplied in which the response for the current
+ *             expo is precalculated, apply() then only needs a single table lookup.
  *  \author    Daniel van den Ouden
  *  \date      Feb-2012
  *  \copyright Public Domain.
@@ -32,11 +34,22 @@ namespace rc
 class Expo : public InputModifier
 {
 public:
+	/*! \brief Nameless enum, magic number hiding. */
+	enum
+	{
+		TableSize = 256 //!< Size of the response table in bytes, one entry per input [0 - 255]
+	};
+	
 	/*! \brief Constructs an Expo object
 	    \param p_expo The expo to set, range [-100 - 100].
 	    \param p_index Input index to use for input and output.*/
 	Expo(int8_t p_expo = 0, Input p_index = Input_None);
 	
+	/*! \brief Copy constructor, copies the expo and input index.
+	    \param p_rhs Object to copy.
+	    \note The copy has no response table, it never shares the buffer of the original.*/
+	Expo(const Expo& p_rhs);
+	
 	
 	/*! \brief Sets the expo.
 	    \param p_expo The expo to set, range [-100 - 100].*/
@@ -46,9 +59,17 @@ public:
 	    \return The current expo, range [-100 - 100].*/
 	int8_t get() const;
 	
-	/*! \brief Copy assignment operator.
+	/*! \brief Sets a buffer for the precalculated response table.
+	    \param p_table Buffer of TableSize bytes, 0 to calculate every value in apply().
+	                   Every Expo object needs its own buffer.
+	    \warning When modifying the expo through a pointer apply() falls back to calculating
+	              every value until the expo is set using set() or an assignment operator.*/
+	void setTable(uint8_t* p_table);
+	
+	/*! \brief Copy assignment operator, copies the expo and input index.
 	    \param p_rhs Object to copy.
-	    \return Reference to this object.*/
+	    \return Reference to this object.
+	    \note Keeps the response table of this object and rebuilds it, never the one of p_rhs.*/
 	Expo& operator = (const Expo& p_rhs);
 	
 	/*! \brief Assignment operator, sets expo.
@@ -77,7 +98,18 @@ public:
 	void apply() const;
 	
 private:
-	int8_t m_expo;
+	/*! \brief Calculates expo.
+	    \param p_value Source value to apply expo to, range [-256 - 256].
+	    \return expo applied to p_value.*/
+	int16_t calculate(int16_t p_value) const;
+	
+	/*! \brief Fills the response table for the current expo.
+	    \param p_force Fill the table even if it has already been built for the current expo.*/
+	void buildTable(bool p_force = false);
+	
+	int8_t   m_expo;
+	int8_t   m_tableExpo; //!< Expo for which the response table has been built
+	uint8_t* m_table;     //!< Response table for input [0 - 255], 0 if not used
 	
 };
 /** \example expo_example.pde
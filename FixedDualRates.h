@@ -0,0 +1,83 @@
+#ifndef INC_RC_FIXEDDUALRATES_H
+#define INC_RC_FIXEDDUALRATES_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** FixedDualRates.h
+** Dual rates with a rate which is fixed at compile time
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <InputModifier.h>
+
+
+namespace rc
+{
+
+/*! 
+ *  \brief     Class to encapsulate dual rates functionality for a rate known at compile time.
+ *  \details   This class gives the same results as DualRates, the division by 100 is replaced
+ *             by a multiplication and shift calculated by the compiler.
+ *  \param     R The rate, range [0 - 140].
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+template<uint8_t R>
+class FixedDualRates : public InputModifier
+{
+public:
+	/*! \brief Constructs a FixedDualRates object
+	    \param p_index Input index to use as input/output.*/
+	FixedDualRates(Input p_index = Input_None) : InputModifier(p_index) { }
+	
+	/*! \brief Gets rate.
+	    \return The rate, range [0 - 140].*/
+	uint8_t get() const { return R; }
+	
+	/*! \brief Applies dual rates.
+	    \param p_value Source value to apply d/r to, range [-256 - 256].
+	    \return d/r applied p_value, range 140% [-358 - 358].*/
+	int16_t apply(int16_t p_value) const
+	{
+		if (R == 100)
+		{
+			return p_value;
+		}
+		
+		uint8_t neg = p_value < 0;
+		uint16_t val = static_cast<uint16_t>(neg ? -p_value : p_value);
+		
+		// (val * R) / 100 for val <= 256, exact because the error of Mul stays below 1/100
+		val = static_cast<uint16_t>((static_cast<uint32_t>(val) * Mul) >> 16);
+		return neg ? -static_cast<int16_t>(val) : static_cast<int16_t>(val);
+	}
+	
+	/*! \brief Applies dual rates to configured input.*/
+	void apply() const
+	{
+		if (m_index != Input_None)
+		{
+			rc::setInput(m_index, apply(rc::getInput(m_index)));
+		}
+	}
+	
+private:
+	static const uint32_t Mul = (R * 65536UL + 99) / 100; //!< R / 100 in 1/65536 units, rounded up.
+};
+/** \example fixeddualrates_example.pde
+ * This is an example of how to use the FixedDualRates class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_FIXEDDUALRATES_H
@@ -0,0 +1,146 @@
+#ifndef INC_RC_FIXEDEXPO_H
+#define INC_RC_FIXEDEXPO_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** FixedExpo.h
+** Expo with an expo value which is fixed at compile time
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+#include <avr/pgmspace.h>
+
+#include <InputModifier.h>
+
+
+namespace rc
+{
+
+/*! \brief Points of the expo curves used by Expo, including 0 and 256.
+    \param I Index of the point, range [0 - 16], input value I * 16.*/
+template<uint8_t I> struct ExpoPoint;
+
+#define RC_EXPO_POINT(I, POS, NEG) \
+	template<> struct ExpoPoint<I> { enum { Pos = POS, Neg = NEG }; };
+
+// based on x^3 and x^(1/3)
+RC_EXPO_POINT( 0,   0,   0)
+RC_EXPO_POINT( 1,   0, 101)
+RC_EXPO_POINT( 2,   1, 128)
+RC_EXPO_POINT( 3,   2, 147)
+RC_EXPO_POINT( 4,   4, 161)
+RC_EXPO_POINT( 5,   8, 174)
+RC_EXPO_POINT( 6,  14, 185)
+RC_EXPO_POINT( 7,  21, 194)
+RC_EXPO_POINT( 8,  32, 203)
+RC_EXPO_POINT( 9,  46, 211)
+RC_EXPO_POINT(10,  63, 219)
+RC_EXPO_POINT(11,  83, 226)
+RC_EXPO_POINT(12, 108, 232)
+RC_EXPO_POINT(13, 137, 239)
+RC_EXPO_POINT(14, 171, 245)
+RC_EXPO_POINT(15, 210, 251)
+RC_EXPO_POINT(16, 256, 256)
+
+#undef RC_EXPO_POINT
+
+
+/*! 
+ *  \brief     Class to encapsulate Expo functionality for an expo known at compile time.
+ *  \details   This class provides the same exponential transformation as Expo.
+ *             The blend between the linear and expo curve is calculated by the compiler,
+ *             apply() interpolates between 17 precalculated points without any division.
+ *             Results may differ by 1 from Expo due to rounding.
+ *  \param     E The expo, range [-100 - 100].
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ */
+template<int8_t E>
+class FixedExpo : public InputModifier
+{
+public:
+	/*! \brief Constructs a FixedExpo object
+	    \param p_index Input index to use for input and output.*/
+	FixedExpo(Input p_index = Input_None) : InputModifier(p_index) { }
+	
+	/*! \brief Gets expo.
+	    \return The expo, range [-100 - 100].*/
+	int8_t get() const { return E; }
+	
+	/*! \brief Applies expo.
+	    \param p_value Source value to apply expo to, range [-256 - 256].
+	    \return expo applied to p_value.*/
+	int16_t apply(int16_t p_value) const
+	{
+		if (E == 0)
+		{
+			return p_value;
+		}
+		
+		// save sign
+		uint8_t neg = p_value < 0;
+		uint16_t value = static_cast<uint16_t>(neg ? -p_value : p_value);
+		
+		uint8_t index = value >> 4;   // divide by 16
+		uint8_t rem   = value & 0x0F; // remainder of divide by 16
+		
+		// linear interpolation on blended points, which are in 1/8 units
+		uint16_t out = (pgm_read_word(s_points + index) * (16 - rem) +
+		                pgm_read_word(s_points + index + 1) * rem + 64) >> 7;
+		
+		return neg ? -static_cast<int16_t>(out) : static_cast<int16_t>(out);
+	}
+	
+	/*! \brief Applies expo to the set input.*/
+	void apply() const
+	{
+		if (m_index != Input_None)
+		{
+			rc::setInput(m_index, apply(rc::getInput(m_index)));
+		}
+	}
+	
+private:
+	enum
+	{
+		Abs = E < 0 ? -E : E
+	};
+	
+	// weighted average between linear and expo value, in 1/8 units
+	template<uint8_t I>
+	struct Point
+	{
+		enum
+		{
+			Value = ((16L * I * (100 - Abs) + static_cast<long>(E > 0 ? ExpoPoint<I>::Pos : ExpoPoint<I>::Neg) * Abs) * 8 + 50) / 100
+		};
+	};
+	
+	static const uint16_t s_points[18]; //!< Blended points, the last one repeated for input 256.
+};
+/** \example fixedexpo_example.pde
+ * This is an example of how to use the FixedExpo class.
+ */
+
+template<int8_t E>
+const uint16_t FixedExpo<E>::s_points[18] PROGMEM =
+{
+	Point< 0>::Value, Point< 1>::Value, Point< 2>::Value, Point< 3>::Value,
+	Point< 4>::Value, Point< 5>::Value, Point< 6>::Value, Point< 7>::Value,
+	Point< 8>::Value, Point< 9>::Value, Point<10>::Value, Point<11>::Value,
+	Point<12>::Value, Point<13>::Value, Point<14>::Value, Point<15>::Value,
+	Point<16>::Value, Point<16>::Value
+};
+
+
+} // namespace end
+
+#endif // INC_RC_FIXEDEXPO_H
@@ -13,8 +13,10 @@
 
 #include <Arduino.h>
 
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
 #include <FlightTimer.h>
+#include <rc_tick.h>
 
 // these need to be included after rc_debug_lib.h
 #include <Buzzer.h>
@@ -91,7 +93,7 @@ void FlightTimer::reset()
 	// the direction is only cosmetical, we always start at 0 and count up
 	m_time = 0;
 	m_millis = 0;
-	m_last = static_cast<uint16_t>(millis());
+	m_last = rc::tick::getMillis();
 }
 
 
@@ -99,7 +101,7 @@ void FlightTimer::update(bool p_active)
 {
 	if (p_active)
 	{
-		uint16_t now = static_cast<uint16_t>(millis());
+		uint16_t now = rc::tick::getMillis();
 		if (now == m_last)
 		{
 			// called too fast
@@ -15,7 +15,9 @@
 #include <Arduino.h>
 
 #include <FlycamOne.h>
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
+#include <rc_tick.h>
 
 
 namespace rc
@@ -152,11 +154,11 @@ int16_t FlycamOne::update()
 		{
 			// just starting
 			m_value     = Value_High;
-			m_startTime = static_cast<uint16_t>(millis());
+			m_startTime = rc::tick::getMillis();
 		}
 		else
 		{
-			uint16_t delta = static_cast<uint16_t>(millis()) - m_startTime;
+			uint16_t delta = rc::tick::getMillis() - m_startTime;
 			if (delta >= m_duration)
 			{
 				if (m_coolDown == false)
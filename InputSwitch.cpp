@@ -12,6 +12,7 @@
 ** -------------------------------------------------------------------------*/
 
 #include <InputSwitch.h>
+#define RC_MODULE RC_MODULE_SWITCH
 #include <rc_debug_lib.h>
 
 
@@ -12,6 +12,7 @@
 ** -------------------------------------------------------------------------*/
 
 #include <InputToOutputPipe.h>
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
 
 
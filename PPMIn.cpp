@@ -15,14 +15,24 @@
 
 #include <inputchannel.h>
 #include <PPMIn.h>
+#define RC_MODULE RC_MODULE_PPM
 #include <rc_debug_lib.h>
 #include <Timer1.h>
 #include <rc_pcint.h>
+#include <util.h>
 
 
 namespace rc
 {
 
+enum
+{
+	CapturePin = 8 //!< ICP1, timed by the Timer 1 input capture unit
+};
+
+PPMIn* PPMIn::s_captureInstance = 0;
+
+
 // Public functions
 
 PPMIn::PPMIn()
@@ -31,20 +41,23 @@ m_state(State_Startup),
 m_channels(0),
 m_pauseLength(8000),
 m_timeout(500),
+m_head(0),
+m_tail(0),
+m_sequence(0),
+m_lastSequence(0xFFFF),
+m_dropped(0),
 m_idx(0),
-m_newFrame(false),
 m_lastFrameTime(0),
+m_frameEndTime(0),
+m_stableChannels(0),
 m_lastTime(0),
-m_high(false)
-#ifdef RC_USE_PCINT
-,m_pin(0)
-#endif
+m_high(false),
+m_pin(0)
 {
-	
+	resetStats();
 }
 
 
-#ifdef RC_USE_PCINT
 void PPMIn::setPin(uint8_t p_pin)
 {
 	RC_TRACE("set pin: %u", p_pin);
@@ -57,7 +70,6 @@ uint8_t PPMIn::getPin() const
 {
 	return m_pin;
 }
-#endif // RC_USE_PCINT
 
 
 void PPMIn::start(bool p_high)
@@ -67,11 +79,18 @@ void PPMIn::start(bool p_high)
 	
 	// check if Timer 1 is running or not
 	rc::Timer1::start();
-
+	
+	if (m_pin == CapturePin)
+	{
+		// let the hardware time the edges we're interested in
+		pinMode(m_pin, INPUT);
+		s_captureInstance = this;
+		rc::Timer1::setInputCapture(true, m_high, PPMIn::handleCapture);
+	}
 #ifdef RC_USE_PCINT
-	// register pin change interrupt
-	if (m_pin != 0)
+	else if (m_pin != 0)
 	{
+		// register pin change interrupt
 		pcint::enable(m_pin, PPMIn::isr, this);
 	}
 #endif // RC_USE_PCINT
@@ -80,8 +99,13 @@ void PPMIn::start(bool p_high)
 
 void PPMIn::stop()
 {
+	if (m_pin == CapturePin)
+	{
+		rc::Timer1::setInputCapture(false, m_high);
+		s_captureInstance = 0;
+	}
 #ifdef RC_USE_PCINT
-	if (m_pin != 0)
+	else if (m_pin != 0)
 	{
 		pcint::disable(m_pin);
 	}
@@ -137,6 +161,34 @@ uint8_t PPMIn::getChannels() const
 }
 
 
+uint16_t PPMIn::getDroppedFrames() const
+{
+	return m_dropped;
+}
+
+
+void PPMIn::getStats(InputStats& p_stats) const
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	p_stats = m_stats;
+	SREG = oldSREG;
+}
+
+
+void PPMIn::resetStats()
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	m_stats.frames         = 0;
+	m_stats.confused       = 0;
+	m_stats.timeouts       = 0;
+	m_stats.channelChanges = 0;
+	m_stats.maxGap         = 0;
+	SREG = oldSREG;
+}
+
+
 void PPMIn::pinChanged(bool p_high)
 {
 	if (p_high != m_high)
@@ -150,13 +202,66 @@ void PPMIn::pinChanged(bool p_high)
 	uint16_t cnt = TCNT1;
 	SREG = oldSREG;
 	
+	handleEdge(cnt);
+}
+
+
+bool PPMIn::update()
+{
+	uint8_t head = m_head;
+	if (head != m_tail)
+	{
+		RC_TRACE("received new frame");
+		memoryBarrier(); // don't read the frame before m_head
+		
+		// only the newest frame is used, the gap in sequence numbers tells how many we've missed
+		const Frame& frame = m_frames[(head - 1) & (FrameCount - 1)];
+		m_dropped += frame.sequence - m_lastSequence - 1;
+		m_lastSequence = frame.sequence;
+		
+		ticksToMicros(frame.timings, getRawInputChannels(), frame.channels < RC_MAX_CHANNELS ? frame.channels : RC_MAX_CHANNELS);
+		
+		// hand the frames back to the interrupt routine
+		memoryBarrier();
+		m_tail = head;
+		
+		// the failsafe reads the live time, it mustn't depend on rc::tick being updated
+		m_lastFrameTime = millis();
+		return true;
+	}
+	else if (m_state == State_Stable)
+	{
+		uint16_t delta = static_cast<uint16_t>(millis()) - m_lastFrameTime;
+		if (delta >= m_timeout)
+		{
+			// signal lost
+			RC_TRACE("lost signal");
+			uint8_t oldSREG = SREG;
+			cli();
+			m_state = State_Lost;
+			++m_stats.timeouts;
+			m_frameEndTime = 0; // don't count the time without signal as a gap
+			SREG = oldSREG;
+		}
+	}
+	return false;
+}
+
+
+// Private functions
+
+void PPMIn::handleEdge(uint16_t p_time)
+{
+	// wraps around with the timer, also where int is wider than 16 bits
+	uint16_t delta = p_time - m_lastTime;
+	
 	switch (m_state)
 	{
 	default:
 	case State_Startup:
 	case State_Lost:
 		{
-			if (cnt - m_lastTime >= m_pauseLength)
+			if (delta >= m_pauseLength)
 			{
 				m_state = State_Listening;
 				m_channels = 0;
@@ -166,17 +271,21 @@ void PPMIn::pinChanged(bool p_high)
 	
 	case State_Listening:
 		{
-			if (cnt - m_lastTime >= m_pauseLength)
+			if (delta >= m_pauseLength)
 			{
 				m_state = State_Stable;
-				m_idx = 0;
-				m_newFrame = true;
+				if (m_stableChannels != 0 && m_channels != m_stableChannels)
+				{
+					++m_stats.channelChanges;
+				}
+				m_stableChannels = m_channels;
+				endFrame();
 			}
 			else
 			{
 				if (m_channels < RC_MAX_CHANNELS)
 				{
-					m_work[m_channels] = cnt - m_lastTime;
+					m_frames[m_head].timings[m_channels] = delta;
 				}
 				++m_channels;
 			}
@@ -185,62 +294,73 @@ void PPMIn::pinChanged(bool p_high)
 	
 	case State_Stable:
 		{
-			if (cnt - m_lastTime >= m_pauseLength)
+			if (delta >= m_pauseLength)
 			{
 				if (m_idx == m_channels)
 				{
-					m_idx = 0;
-					m_newFrame = true;
+					endFrame();
 				}
 				else
 				{
 					m_state = State_Confused;
+					++m_stats.confused;
 				}
 			}
 			else
 			{
 				if (m_idx < RC_MAX_CHANNELS)
 				{
-					m_work[m_idx] = cnt - m_lastTime;
+					m_frames[m_head].timings[m_idx] = delta;
 				}
 				++m_idx;
 			}
 		}
 		break;
 	}
-	m_lastTime = cnt;
+	m_lastTime = p_time;
 }
 
 
-bool PPMIn::update()
+void PPMIn::endFrame()
 {
-	if (m_newFrame)
+	m_idx = 0;
+	
+	Frame& frame = m_frames[m_head];
+	frame.sequence = m_sequence;
+	frame.channels = m_channels;
+	++m_sequence;
+	
+	++m_stats.frames;
+	uint32_t now = micros();
+	if (m_frameEndTime != 0)
 	{
-		RC_TRACE("received new frame");
-		m_newFrame = false;
-		m_lastFrameTime = static_cast<uint16_t>(millis());
-		uint16_t* results = getRawInputChannels();
-		for (uint8_t i = 0; i < m_channels && i < RC_MAX_CHANNELS; ++i)
+		uint32_t gap = now - m_frameEndTime;
+		if (gap > m_stats.maxGap)
 		{
-			results[i] = m_work[i] >> 1;
+			m_stats.maxGap = gap > 0xFFFF ? 0xFFFF : gap;
 		}
-		return true;
 	}
-	else if (m_state == State_Stable)
+	m_frameEndTime = now;
+	
+	// when the queue is full this frame is dropped, the next frame will overwrite it
+	uint8_t next = (m_head + 1) & (FrameCount - 1);
+	if (next != m_tail)
 	{
-		uint16_t delta = static_cast<uint16_t>(millis()) - m_lastFrameTime;
-		if (delta >= m_timeout)
-		{
-			// signal lost
-			RC_TRACE("lost signal");
-			m_state = State_Lost;
-		}
+		memoryBarrier(); // finish writing the frame before publishing it
+		m_head = next;
 	}
-	return false;
 }
 
 
-// Private functions
+void PPMIn::handleCapture()
+{
+	// ICR1 holds the Timer 1 count latched at the edge
+	if (s_captureInstance != 0)
+	{
+		s_captureInstance->handleEdge(ICR1);
+	}
+}
+
 
 #ifdef RC_USE_PCINT
 void PPMIn::isr(uint8_t p_pin, bool p_high, void* p_user)
@@ -16,6 +16,7 @@
 
 #include <inttypes.h>
 
+#include <inputchannel.h>
 #include <rc_config.h>
 
 
@@ -25,6 +26,10 @@ namespace rc
 /*! 
  *  \brief     Class to encapsulate PPM Input functionality.
  *  \details   This class provides a way to decode a PPM signal.
+ *             Decoded frames are passed from the interrupt routine to update() through a
+ *             small queue, so a frame is never partially overwritten while it's being read.
+ *             On pin 8 (ICP1) the edges are timed by the Timer1 input capture unit,
+ *             which is not affected by the latency of interrupt handling.
  *  \author    Daniel van den Ouden
  *  \date      Feb-2012
  *  \copyright Public Domain.
@@ -37,15 +42,14 @@ public:
 	/*! \brief Constructs a PPMIn object.*/
 	PPMIn();
 	
-#ifdef RC_USE_PCINT
 	/*! \brief Sets pin on which PPM signal is received.
-	    \param p_pin The pin on which a PPM signal is received.*/
+	    \param p_pin The pin on which a PPM signal is received.
+	    \note Pin 8 uses the Timer1 input capture unit, other pins need RC_USE_PCINT.*/
 	void setPin(uint8_t p_pin);
 	
 	/*! \brief Gets pin on which PPM signal is received.
 	    \return The pin on which a PPM signal is received.*/
 	uint8_t getPin() const;
-#endif
 	
 	/*! \brief Starts measuring.
 	    \param p_high Whether the incoming signal has high or low pulses.
@@ -55,13 +59,14 @@ public:
 	          the p_high parameter will make the interrupt handler respond to either
 	          the high or low pin change and may thus reduce problems created by
 	          simultaneous interrupts.
-	    \note Will register pin change interrupt if you're using that.
+	    \note Will register pin change interrupt if you're using that, or
+	          enable the input capture interrupt for pin 8.
 	    \warning Do <b>NOT</b> use this together with the standard Arduino Servo library,
 	             use rc::ServoOut instead.*/
 	void start(bool p_high = false);
 	
 	/*! \brief Stops measuring.
-	    \note Will unregister pin change interrupt if you're using that.*/
+	    \note Will unregister pin change or input capture interrupt.*/
 	void stop();
 	
 	/*! \brief Sets minimum pause length, including pulse, in microseconds.
@@ -74,7 +79,9 @@ public:
 	
 	/*! \brief Sets minimum amount of time without signal after which the signal is considered lost.
 	    \param p_length Minimum timeout time in milliseconds.
-	    \warning Don't set this lower than your expected frame length (total length of pause + channels). */
+	    \warning Don't set this lower than your expected frame length (total length of pause + channels).
+	    \note The timeout is checked against millis(), not rc::tick, so it works whether or not
+	           the sketch calls rc::tick::update().*/
 	void setTimeout(uint16_t p_length);
 	
 	/*! \brief Gets amount of time without signal after which the signal is considered lost.
@@ -93,17 +100,35 @@ public:
 	    \return The number of channels found in the last received signal. */
 	uint8_t getChannels() const;
 	
+	/*! \brief Gets the number of frames which have been received but have not been passed on by update().
+	    \return Number of dropped frames since construction, wraps around after 65535.
+	    \note Frames are dropped when update() isn't called at least once every frame. */
+	uint16_t getDroppedFrames() const;
+	
+	/*! \brief Gets statistics about the quality of the signal.
+	    \param p_stats Copy of the statistics, consistent since it's taken with interrupts disabled.
+	    \note The gap between two frames is only measured while the signal isn't lost.*/
+	void getStats(InputStats& p_stats) const;
+	
+	/*! \brief Resets all statistics to 0.*/
+	void resetStats();
+	
 	/*! \brief Handles pin change interrupt.
 	    \param p_high Whether the pin is high or not.
 	    \note Call this from your interrupt handler if you're handling interrupts yourself.*/
 	void pinChanged(bool p_high);
 	
-	/*! \brief Updates the result buffer with new values.
+	/*! \brief Updates the result buffer with the newest received frame.
 	    \return Whether anything has been updated.
 	    \note Call this often to detect loss of signal early.*/
 	bool update();
 	
 private:
+	enum
+	{
+		FrameCount = 4 //!< Size of the frame queue, must be a power of 2.
+	};
+	
 	enum State
 	{
 		State_Startup,   //!< Just started, no signal received yet.
@@ -113,27 +138,51 @@ private:
 		State_Lost       //!< Signal has been lost (no valid signal for a while).
 	};
 	
+	struct Frame
+	{
+		uint16_t sequence;                 //!< Number of the frame, increases by one for every received frame.
+		uint8_t  channels;                 //!< Number of channels in the frame.
+		uint16_t timings[RC_MAX_CHANNELS]; //!< Channel timings in Timer1 ticks.
+	};
+	
+	/*! \brief Handles an edge of the signal, called from the interrupt routine.
+	    \param p_time Timer 1 count at the edge.*/
+	void handleEdge(uint16_t p_time);
+	
+	/*! \brief Completes the frame being received and queues it, called from the interrupt routine.*/
+	void endFrame();
+	
+	static void handleCapture();
+	
 #ifdef RC_USE_PCINT
 	static void isr(uint8_t p_pin, bool p_high, void* p_user);
 #endif
 	
+	static PPMIn* s_captureInstance; //!< Instance using input capture
+	
 	State    m_state;       //!< Current state of input signal.
 	uint8_t  m_channels;    //!< Number of channels in input signal.
 	uint16_t m_pauseLength; //!< Minimum pause length in microseconds.
 	uint16_t m_timeout;     //!< Time in milliseconds without signal after which the signal is considered "lost".
 	
-	uint16_t m_work[RC_MAX_CHANNELS]; //!< Work buffer.
-	uint8_t  m_idx;                   //!< Current index in buffer.
+	Frame            m_frames[FrameCount]; //!< Frame queue, the frame at m_head is being received.
+	volatile uint8_t m_head;               //!< Frame being received, only changed by the interrupt routine.
+	volatile uint8_t m_tail;               //!< Oldest unread frame, only changed by update().
+	uint16_t         m_sequence;           //!< Sequence number of the frame being received.
+	uint16_t         m_lastSequence;       //!< Sequence number of the last frame passed on by update().
+	uint16_t         m_dropped;            //!< Number of frames not passed on by update().
+	uint8_t          m_idx;                //!< Current index in frame being received.
 	
-	volatile bool m_newFrame;      //!< Whether a new frame is available or not.
-	uint16_t      m_lastFrameTime; //!< Last time a new frame has been found
+	uint16_t m_lastFrameTime; //!< Last time a new frame has been found
+	
+	InputStats m_stats;          //!< Signal statistics, kept by the interrupt routine.
+	uint32_t   m_frameEndTime;   //!< Time in microseconds of the last frame end, 0 if unknown.
+	uint8_t    m_stableChannels; //!< Number of channels in the last stable signal.
 	
 	uint16_t m_lastTime; //!< Time of last interrupt.
 	bool     m_high;     //!< Whether the incoming signal uses high pulses.
-
-#ifdef RC_USE_PCINT
+	
 	uint8_t m_pin;
-#endif
 };
 /** \example ppmin_example.pde
  * This is an example of how to use the PPMIn class.
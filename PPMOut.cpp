@@ -15,6 +15,7 @@
 
 #include <outputchannel.h>
 #include <PPMOut.h>
+#define RC_MODULE RC_MODULE_PPM
 #include <rc_debug_lib.h>
 #include <Timer1.h>
 
@@ -32,7 +33,15 @@ PPMOut::PPMOut(uint8_t p_channels)
 m_pulseLength(500),
 m_pauseLength(10500),
 m_channelCount(p_channels),
-m_timingCount((p_channels + 1) * 2)
+m_active(m_frames),
+m_back(m_frames + 1),
+m_newFrame(false),
+m_timingPos(0),
+m_mask(0),
+m_port(0),
+m_out(0),
+m_compare(Timer1::Compare_None),
+m_ocr(0)
 {
 	s_instance = this;
 }
@@ -42,42 +51,68 @@ void PPMOut::start(uint8_t p_pin, bool p_invert)
 {
 	RC_TRACE("start pin: %u invert: %d", p_pin, p_invert);
 	
-	// stop timer 1
-	rc::Timer1::stop();
+	// release the compare unit of a previous start, Timer1 itself keeps running for its other users
+	stop();
 	
-	// Fill channelTimings buffer with data from channels buffer
-	update();
-	
-	// Fill timings buffer with data from channelTimings buffer (set up a complete PPM frame)
-	updateTimings();
+	// Set up a complete PPM frame, our interrupt is off so we can write the active frame
+	m_newFrame = false;
+	updateTimings(m_active);
 	
 	m_timingPos = p_invert ? 0 : 1;
 	
 	pinMode(p_pin, OUTPUT);
 	
-	// First disable the output compare match A interrupt
-	rc::Timer1::setCompareMatch(false, true);
-	
-	// Configure timer1 Toggle OC1A/OC1B on Compare Match
+	// pins 9 and 10 need their own compare unit, which toggles OC1A/OC1B on Compare Match
+	Timer1::Compare compare = Timer1::Compare_None;
 	if (p_pin == 9 || p_pin == 10)
 	{
-		rc::Timer1::setToggle(true, p_pin == 9);
+		m_port = 0;
+		compare = p_pin == 9 ? Timer1::Compare_A : Timer1::Compare_B;
 	}
 	else
 	{
 		m_mask = digitalPinToBitMask(p_pin);
 		uint8_t port = digitalPinToPort(p_pin);
 		m_port = portInputRegister(port);
+		m_out  = portOutputRegister(port);
 	}
 	
-	// set compare value
-	OCR1A = TCNT1 + m_timings[p_invert ? m_timingCount - 1 : 0];
+	// start the timer if nobody did yet
+	rc::Timer1::start();
 	
-	// enable timer output compare match A interrupts
-	rc::Timer1::setCompareMatch(true, true, PPMOut::handleInterrupt);
+	// claim a compare unit and set the first compare value
+	m_compare = rc::Timer1::claimCompare(PPMOut::handleInterrupt,
+	                                     m_active->timings[p_invert ? m_active->count - 1 : 0],
+	                                     compare);
+	if (m_compare == Timer1::Compare_None)
+	{
+		RC_ERROR("no compare unit for pin %u", p_pin);
+		return;
+	}
+	m_ocr = rc::Timer1::getCompareRegister(m_compare);
 	
-	// start the timer
-	rc::Timer1::start();
+	if (m_port == 0)
+	{
+		rc::Timer1::setToggle(true, m_compare == Timer1::Compare_A);
+	}
+}
+
+
+void PPMOut::stop()
+{
+	RC_TRACE("stop");
+	
+	// the interrupt toggles the pin, so leave it low or the next start sends inverted pulses,
+	// releasing the compare unit also leaves pin 9 or 10 low
+	uint8_t oldSREG = SREG;
+	cli();
+	rc::Timer1::releaseCompare(m_compare);
+	if (m_compare != Timer1::Compare_None && m_port != 0)
+	{
+		*m_out &= ~m_mask;
+	}
+	m_compare = Timer1::Compare_None;
+	SREG = oldSREG;
 }
 
 
@@ -125,13 +160,28 @@ uint16_t PPMOut::getPauseLength() const
 }
 
 
+Timer1::Compare PPMOut::getCompare() const
+{
+	return m_compare;
+}
+
+
 void PPMOut::update()
 {
-	const uint16_t* channels = getRawOutputChannels();
-	for (uint8_t i = 0; i < m_channelCount; ++i)
-	{
-		m_channelTimings[i] = channels[i] << 1;
-	}
+	// take back a frame that hasn't been sent yet, the interrupt routine won't swap while we're busy
+	uint8_t oldSREG = SREG;
+	cli();
+	m_newFrame = false;
+	Frame* frame = m_back;
+	SREG = oldSREG;
+	
+	updateTimings(frame);
+	
+	// hand the frame to the interrupt routine, it will be sent after the current one
+	oldSREG = SREG;
+	cli();
+	m_newFrame = true;
+	SREG = oldSREG;
 }
 
 
@@ -146,11 +196,12 @@ void PPMOut::handleInterrupt()
 
 // Private functions
 
-void PPMOut::updateTimings()
+void PPMOut::updateTimings(Frame* p_frame)
 {
-	uint16_t* scratch = m_timings;
+	const uint16_t* channels = getRawOutputChannels();
+	uint16_t* scratch = p_frame->timings;
 	
-	// copy all pre-calculated timings
+	// calculate all timings
 	for (uint8_t i = 0; i < m_channelCount; ++i)
 	{
 		// set pulse length
@@ -158,7 +209,7 @@ void PPMOut::updateTimings()
 		++scratch;
 		
 		// set timing
-		*scratch = m_channelTimings[i] - m_pulseLength;
+		*scratch = (channels[i] << 1) - m_pulseLength;
 		++scratch;
 	}
 	
@@ -170,29 +221,37 @@ void PPMOut::updateTimings()
 	*scratch = m_pauseLength - m_pulseLength;
 	
 	// update number of timings
-	m_timingCount = (m_channelCount + 1) * 2;
+	p_frame->count = (m_channelCount + 1) * 2;
 }
 
 
 void PPMOut::isr()
 {
 	// set the compare register with the next value
-	OCR1A += m_timings[m_timingPos];
+	*m_ocr += m_active->timings[m_timingPos];
 	
 	// toggle pin, pins 9 and 10 will toggle themselves
+	// writing a one to the input register toggles only our pin, reading it back
+	// would toggle every other pin of the port which is high at the moment
 	if (m_port != 0)
 	{
-		*m_port |= m_mask;
+		*m_port = m_mask;
 	}
 	
 	// update position
 	++m_timingPos;
-	if (m_timingPos >= m_timingCount)
+	if (m_timingPos >= m_active->count)
 	{
 		m_timingPos = 0;
 		
-		// we're at the end of frame here, so there's plenty of time to update
-		updateTimings();
+		// we're at the end of frame here, switch to the new frame if there is one
+		if (m_newFrame)
+		{
+			Frame* frame = m_active;
+			m_active = m_back;
+			m_back = frame;
+			m_newFrame = false;
+		}
 	}
 }
 
@@ -17,6 +17,7 @@
 #include <inttypes.h>
 
 #include <rc_config.h>
+#include <Timer1.h>
 
 
 namespace rc
@@ -43,11 +44,19 @@ public:
 	    \param p_pin Pin to use as output pin, pins 9 and 10 are preferred and give the best result.
 	    \param p_invert Invert the signal on true.
 	    \note If precise timing is of importance then you should use either pin 9 or 10,
-		      these can be toggled by the timer hardware and will give the best results. */
+		      these can be toggled by the timer hardware and will give the best results.
+	    \note Pin 9 needs compare unit A of Timer1 and pin 10 unit B, other pins take any free unit.
+	           ServoOut takes B when it's free, so use pin 9 when using both.*/
 	void start(uint8_t p_pin, bool p_invert = false);
 	
+	/*! \brief Stops output and releases the compare unit, Timer1 keeps running.
+	    \details The pin is driven low, so a pulse in progress is cut short and the next start
+	              begins with the right polarity.*/
+	void stop();
+	
 	/*! \brief Sets channel count
-	    \param p_channels Channel count.*/
+	    \param p_channels Channel count.
+	    \note Takes effect on the next call to update().*/
 	void setChannelCount(uint8_t p_channels);
 	
 	/*! \brief Gets channel count.
@@ -55,7 +64,8 @@ public:
 	uint8_t getChannelCount() const;
 	
 	/*! \brief Sets pulse length in microseconds.
-	    \param p_length Pulse length in microseconds.*/
+	    \param p_length Pulse length in microseconds.
+	    \note Takes effect on the next call to update().*/
 	void setPulseLength(uint16_t p_length);
 	
 	/*! \brief Gets pulse length in microseconds.
@@ -63,22 +73,38 @@ public:
 	uint16_t getPulseLength() const;
 	
 	/*! \brief Sets pause length in microseconds.
-	    \param p_length Pause length in microseconds.*/
+	    \param p_length Pause length in microseconds.
+	    \note Takes effect on the next call to update().*/
 	void setPauseLength(uint16_t p_length);
 	
 	/*! \brief Gets pause length in microseconds.
 	    \return The current pause length in microseconds.*/
 	uint16_t getPauseLength() const;
 	
-	/*! \brief Updates channel timings, will be sent at next frame.*/
+	/*! \brief Gets the compare unit claimed from Timer1.
+	    \return The compare unit, Compare_None when not started.*/
+	Timer1::Compare getCompare() const;
+	
+	/*! \brief Updates channel timings, will be sent at next frame.
+	    \details Builds a complete frame in the back buffer, the interrupt routine
+	              switches to it at the end of the frame it is sending.
+	              A frame that has not been sent yet is replaced by the newer one.*/
 	void update();
 	
 	/*! \brief Handles timer interrupt.*/
 	static void handleInterrupt();
 	
 private:
-	/*! \brief Update the entire timings buffer. */
-	void updateTimings();
+	/*! \brief A complete PPM frame.*/
+	struct Frame
+	{
+		uint8_t  count;                             //!< Number of active timings.
+		uint16_t timings[(RC_MAX_CHANNELS + 1) * 2]; //!< Timing values in timer ticks.
+	};
+	
+	/*! \brief Fills a frame with pulses and channel timings.
+	    \param p_frame Frame to fill, may not be in use by the interrupt routine.*/
+	void updateTimings(Frame* p_frame);
 	
 	/*! \brief Internal interrupt handling. */
 	void isr();
@@ -88,14 +114,18 @@ private:
 	
 	uint8_t m_channelCount;    //!< Number of active channels.
 	
-	volatile uint16_t m_channelTimings[RC_MAX_CHANNELS + 1]; //!< Timings per channel, in timer ticks.
-	
-	uint8_t   m_timingCount;                        //!< Number of active timings.
-	uint8_t   m_timingPos;                          //!< Current position in timings buffer.
-	uint16_t  m_timings[(RC_MAX_CHANNELS + 1) * 2]; //!< Timing values in timer ticks.
+	Frame           m_frames[2]; //!< Frame being sent and frame being prepared.
+	Frame*          m_active;    //!< Frame being sent by the interrupt routine.
+	Frame* volatile m_back;      //!< Frame being prepared by update().
+	volatile bool   m_newFrame;  //!< Whether the back frame is ready to be sent.
+	uint8_t         m_timingPos; //!< Current position in active frame.
 	
 	uint8_t           m_mask; //!< Mask to use for pins other than 9 and 10
 	volatile uint8_t* m_port; //!< Input port register for pins other than 9 and 10
+	volatile uint8_t* m_out;  //!< Output port register for pins other than 9 and 10
+	
+	Timer1::Compare    m_compare; //!< Compare unit claimed from Timer1.
+	volatile uint16_t* m_ocr;     //!< Compare register of the claimed unit.
 	
 	static PPMOut* s_instance; //!< Singleton instance
 };
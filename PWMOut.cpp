@@ -0,0 +1,194 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** PWMOut.cpp
+** Servo Signal Output generated by the Timer1 hardware
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <PWMOut.h>
+#define RC_MODULE RC_MODULE_SERVO
+#include <rc_debug_lib.h>
+#include <Timer1.h>
+
+
+namespace rc
+{
+
+// Public functions
+
+PWMOut::PWMOut(OutputChannel p_pin9, OutputChannel p_pin10)
+:
+m_frameLength(20000)
+{
+	m_channels[0] = p_pin9;
+	m_channels[1] = p_pin10;
+	m_enabled[0]  = false;
+	m_enabled[1]  = false;
+}
+
+
+void PWMOut::start()
+{
+	RC_TRACE("start");
+	
+	// fast PWM mode changes the period of the counter, which would break everyone sharing it
+	if (rc::Timer1::isClaimed())
+	{
+		RC_ERROR("Timer1 is in use");
+		return;
+	}
+	
+	// stop timer 1
+	rc::Timer1::stop();
+	
+	// a period takes TOP + 1 ticks of 0.5 us
+	rc::Timer1::setFastPWM(true, (m_frameLength << 1) - 1);
+	TCNT1 = 0;
+	
+	for (uint8_t i = 0; i < 2; ++i)
+	{
+		rc::Timer1::setPWM(false, i == 0);
+		m_enabled[i] = false;
+		if (m_channels[i] != OutputChannel_None)
+		{
+			uint8_t pin = i == 0 ? 9 : 10;
+			digitalWrite(pin, LOW);
+			pinMode(pin, OUTPUT);
+		}
+	}
+	
+	// set pulse lengths, the compare registers are loaded from their buffers at the start
+	update();
+	
+	// start the timer
+	rc::Timer1::start();
+}
+
+
+void PWMOut::stop()
+{
+	RC_TRACE("stop");
+	
+	// leave Timer1 alone if start refused to take it over
+	if (rc::Timer1::isFastPWM() == false)
+	{
+		return;
+	}
+	rc::Timer1::stop();
+	
+	// the pins go back to their port, which keeps them low
+	rc::Timer1::setPWM(false, true);
+	rc::Timer1::setPWM(false, false);
+	m_enabled[0] = false;
+	m_enabled[1] = false;
+	rc::Timer1::setFastPWM(false);
+}
+
+
+void PWMOut::setChannel(uint8_t p_pin, OutputChannel p_channel)
+{
+	RC_TRACE("set channel pin: %u channel: %u", p_pin, p_channel);
+	RC_ASSERT_MSG(p_pin == 9 || p_pin == 10, "pin %u isn't connected to Timer1", p_pin);
+	RC_ASSERT(p_channel <= OutputChannel_None);
+	
+	m_channels[p_pin == 9 ? 0 : 1] = p_channel;
+}
+
+
+OutputChannel PWMOut::getChannel(uint8_t p_pin) const
+{
+	return m_channels[p_pin == 9 ? 0 : 1];
+}
+
+
+void PWMOut::setFrameLength(uint16_t p_length)
+{
+	RC_TRACE("set frame length: %u us", p_length);
+	RC_ASSERT_MINMAX(p_length, 2500, 32767);
+	
+	m_frameLength = p_length;
+}
+
+
+uint16_t PWMOut::getFrameLength() const
+{
+	return m_frameLength;
+}
+
+
+void PWMOut::update()
+{
+	const uint16_t* values = getRawOutputChannels();
+	for (uint8_t i = 0; i < 2; ++i)
+	{
+		if (m_channels[i] < OutputChannel_Count)
+		{
+			updatePin(i == 0, values[m_channels[i]]);
+		}
+	}
+}
+
+
+// Private functions
+
+void PWMOut::updatePin(bool p_OC1A, uint16_t p_value)
+{
+	uint8_t idx = p_OC1A ? 0 : 1;
+	
+	if (p_value == 0)
+	{
+		// even a compare value of 0 gives a pulse of one tick, let the port keep the pin low
+		if (m_enabled[idx])
+		{
+			// the compare output keeps its level once disconnected, so only let go of it
+			// between pulses, otherwise the next update tries again
+			uint8_t mask = digitalPinToBitMask(p_OC1A ? 9 : 10);
+			
+			uint8_t oldSREG = SREG;
+			cli();
+			if ((PINB & mask) == 0 && TCNT1 < ICR1 - 16)
+			{
+				rc::Timer1::setPWM(false, p_OC1A);
+				m_enabled[idx] = false;
+			}
+			SREG = oldSREG;
+		}
+		return;
+	}
+	
+	RC_ASSERT_MINMAX(p_value, 1, m_frameLength - 1);
+	
+	// the pin is cleared one tick after the counter matches
+	uint16_t ocr = (p_value << 1) - 1;
+	
+	// 16 bit registers share a temporary register with the interrupt routines
+	uint8_t oldSREG = SREG;
+	cli();
+	if (p_OC1A)
+	{
+		OCR1A = ocr;
+	}
+	else
+	{
+		OCR1B = ocr;
+	}
+	SREG = oldSREG;
+	
+	if (m_enabled[idx] == false)
+	{
+		rc::Timer1::setPWM(true, p_OC1A);
+		m_enabled[idx] = true;
+	}
+}
+
+
+// namespace end
+}
@@ -0,0 +1,102 @@
+#ifndef INC_RC_PWMOUT_H
+#define INC_RC_PWMOUT_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** PWMOut.h
+** Servo Signal Output generated by the Timer1 hardware
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <outputchannel.h>
+
+
+namespace rc
+{
+
+/*! 
+ *  \brief     Class to encapsulate hardware Servo Signal Output functionality.
+ *  \details   This class drives up to two servos on pins 9 (OC1A) and 10 (OC1B) with the Fast PWM
+ *             mode of Timer1. The timer hardware sets and clears the pins, so the pulses have no jitter
+ *             at all and take no CPU time, there are no interrupts. This makes it a good choice for
+ *             critical channels like throttle or a tail servo.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \warning   This class takes over Timer1, it can't be used together with ServoOut, PPMOut,
+ *             PPMIn, ServoIn or SBUSIn, nor with the standard Arduino Servo library. start() refuses
+ *             while another class has claimed part of Timer1, and ServoOut and PPMOut can't claim
+ *             a compare unit while PWMOut is running. ServoIn, SBUSIn and PPMIn on other pins
+ *             than 8 only read the counter, these can't be detected.
+ *  \copyright Public Domain.
+ */
+class PWMOut
+{
+public:
+	/*! \brief Constructs a PWMOut object.
+	    \param p_pin9 Output channel to send on pin 9, OutputChannel_None to leave the pin alone.
+	    \param p_pin10 Output channel to send on pin 10, OutputChannel_None to leave the pin alone.*/
+	PWMOut(OutputChannel p_pin9 = OutputChannel_1, OutputChannel p_pin10 = OutputChannel_None);
+	
+	/*! \brief Sets up Timer1 and starts output.
+	    \details Does nothing but report an error if part of Timer1 has been claimed, see Timer1::isClaimed.*/
+	void start();
+	
+	/*! \brief Stops output, Timer1 is stopped and put back in its normal mode.
+	    \note Does nothing if start() didn't take over Timer1.*/
+	void stop();
+	
+	/*! \brief Sets the output channel to send on a pin.
+	    \param p_pin Pin 9 or 10, the only pins connected to Timer1.
+	    \param p_channel Output channel to send on the pin, OutputChannel_None to leave the pin alone.
+	    \note Takes effect on the next call to start().*/
+	void setChannel(uint8_t p_pin, OutputChannel p_channel);
+	
+	/*! \brief Gets the output channel sent on a pin.
+	    \param p_pin Pin 9 or 10.
+	    \return Output channel sent on the pin.*/
+	OutputChannel getChannel(uint8_t p_pin) const;
+	
+	/*! \brief Sets the time from the start of one pulse to the start of the next.
+	    \param p_length Frame length in microseconds, range [2500 - 32767].
+	    \details The default of 20000 is the 50 Hz analog servos expect,
+	             digital servos and ESCs can take 3000 or even 2500.
+	    \note Takes effect on the next call to start().*/
+	void setFrameLength(uint16_t p_length);
+	
+	/*! \brief Gets the time from the start of one pulse to the start of the next.
+	    \return Frame length in microseconds.*/
+	uint16_t getFrameLength() const;
+	
+	/*! \brief Updates the pulse lengths from the output channels.
+	    \details The compare registers are double buffered by the hardware,
+	             new pulse lengths are used from the start of the next frame on.
+	             A pin with an output channel of 0 stays low, the pulse in progress is finished
+	             first, so call this regularly.*/
+	void update();
+	
+private:
+	/*! \brief Updates the pulse length of a pin.
+	    \param p_OC1A Whether to update OC1A (pin 9) or OC1B (pin 10).
+	    \param p_value Pulse length in microseconds, 0 for no pulses.*/
+	void updatePin(bool p_OC1A, uint16_t p_value);
+	
+	OutputChannel m_channels[2]; //!< Output channels sent on pins 9 and 10.
+	uint16_t      m_frameLength; //!< Frame length in microseconds.
+	bool          m_enabled[2];  //!< Whether PWM output of pins 9 and 10 is enabled.
+};
+/** \example pwmout_example.pde
+ * This is an example of how to use the PWMOut class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_PWMOUT_H
@@ -14,7 +14,9 @@
 #include <Arduino.h>
 
 #include <output.h>
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
+#include <rc_tick.h>
 #include <Retracts.h>
 #include <util.h>
 
@@ -195,7 +197,7 @@ void Retracts::update()
 		up();
 	}
 	
-	uint16_t now   = static_cast<uint16_t>(millis());
+	uint16_t now   = rc::tick::getMillis();
 	uint16_t delta = now - m_lastTime;
 	m_lastTime = now;
 	
@@ -0,0 +1,278 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** SBUSIn.cpp
+** SBUS Input functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <inputchannel.h>
+#define RC_MODULE RC_MODULE_PPM
+#include <rc_debug_lib.h>
+#include <rc_uartint.h>
+#include <SBUSIn.h>
+#include <Timer1.h>
+#include <util.h>
+
+
+namespace rc
+{
+
+enum
+{
+	SBUS_BAUD    = 100000,
+	SBUS_HEADER  = 0x0F,
+	SBUS_GAP     = 2000,   //!< Minimum time between frames in Timer1 ticks, 1 ms. Bytes are 120 us apart.
+	
+	Flag_Ch17      = 0x01, //!< Digital channel 17
+	Flag_Ch18      = 0x02, //!< Digital channel 18
+	Flag_FrameLost = 0x04, //!< Receiver missed a frame from the transmitter
+	Flag_Failsafe  = 0x08  //!< Receiver is in failsafe
+};
+
+
+// Public functions
+
+SBUSIn::SBUSIn()
+:
+m_state(State_Startup),
+m_channels(0),
+m_timeout(500),
+m_head(0),
+m_tail(0),
+m_sequence(0),
+m_lastSequence(0xFFFF),
+m_dropped(0),
+m_lost(0),
+m_idx(0),
+m_lastFrameTime(0),
+m_lastTime(0)
+{
+	
+}
+
+
+void SBUSIn::start()
+{
+	RC_TRACE("start");
+	
+	// check if Timer 1 is running or not
+	rc::Timer1::start();
+	
+#ifdef RC_USE_UART
+	uartint::setRxHandler(SBUSIn::isr, this);
+	
+	// 100000 baud, 8 data bits, even parity, 2 stop bits, receive only
+	uint16_t ubrr = (F_CPU / 16 / SBUS_BAUD) - 1;
+	UBRR0H = (ubrr >> 8) & 0x0F;
+	UBRR0L = ubrr & 0xFF;
+	UCSR0A = 0;
+	UCSR0C = _BV(UPM01) | _BV(USBS0) | _BV(UCSZ01) | _BV(UCSZ00);
+	UCSR0B |= _BV(RXEN0) | _BV(RXCIE0);
+#endif // RC_USE_UART
+}
+
+
+void SBUSIn::stop()
+{
+	RC_TRACE("stop");
+	
+#ifdef RC_USE_UART
+	UCSR0B &= ~(_BV(RXEN0) | _BV(RXCIE0));
+	uartint::setRxHandler(0);
+#endif // RC_USE_UART
+}
+
+
+void SBUSIn::setTimeout(uint16_t p_length)
+{
+	RC_TRACE("set timeout: %u ms", p_length);
+	RC_ASSERT_MINMAX(p_length, 0, 32766);
+	
+	m_timeout = p_length;
+}
+
+
+uint16_t SBUSIn::getTimeout() const
+{
+	return m_timeout;
+}
+
+
+bool SBUSIn::isStable() const
+{
+	return m_state == State_Stable;
+}
+
+
+bool SBUSIn::isLost() const
+{
+	return m_state == State_Lost;
+}
+
+
+uint8_t SBUSIn::getChannels() const
+{
+	return m_channels;
+}
+
+
+uint16_t SBUSIn::getLostFrames() const
+{
+	return m_lost;
+}
+
+
+uint16_t SBUSIn::getDroppedFrames() const
+{
+	return m_dropped;
+}
+
+
+void SBUSIn::byteReceived(uint8_t p_byte, bool p_valid)
+{
+	// the gap between frames is the only reliable way to find the start of a frame
+	uint8_t oldSREG = SREG;
+	cli();
+	uint16_t cnt = TCNT1;
+	SREG = oldSREG;
+	
+	uint16_t delta = cnt - m_lastTime;
+	m_lastTime = cnt;
+	
+	if (p_valid == false)
+	{
+		// drop this frame, wait for the next one
+		m_idx = DataSize + 2;
+		return;
+	}
+	
+	if (delta >= SBUS_GAP)
+	{
+		m_idx = 0;
+	}
+	
+	if (m_idx == 0)
+	{
+		if (p_byte == SBUS_HEADER)
+		{
+			m_idx = 1;
+		}
+	}
+	else if (m_idx <= DataSize)
+	{
+		m_frames[m_head].data[m_idx - 1] = p_byte;
+		++m_idx;
+	}
+	else if (m_idx == DataSize + 1)
+	{
+		// footer is 0 for SBUS, SBUS2 uses xxxx0100 for telemetry slots
+		if (p_byte == 0x00 || (p_byte & 0x0F) == 0x04)
+		{
+			endFrame();
+		}
+		++m_idx;
+	}
+	// anything after the footer is ignored until the next gap
+}
+
+
+bool SBUSIn::update()
+{
+	uint8_t head = m_head;
+	if (head != m_tail)
+	{
+		RC_TRACE("received new frame");
+		memoryBarrier(); // don't read the frame before m_head
+		
+		// only the newest frame is used, the gap in sequence numbers tells how many we've missed
+		const Frame& frame = m_frames[(head - 1) & (FrameCount - 1)];
+		m_dropped += frame.sequence - m_lastSequence - 1;
+		m_lastSequence = frame.sequence;
+		
+		uint8_t flags = frame.data[DataSize - 1];
+		bool updated = false;
+		if (flags & Flag_Failsafe)
+		{
+			// the receiver has lost the transmitter, the channels hold failsafe values
+			RC_TRACE("failsafe");
+			m_state = State_Lost;
+		}
+		else
+		{
+			if (flags & Flag_FrameLost)
+			{
+				++m_lost;
+			}
+			
+			// 16 channels of 11 bits
+			uint16_t* results = getRawInputChannels();
+			uint8_t count = Channels < RC_MAX_CHANNELS ? Channels : RC_MAX_CHANNELS;
+			packedToMicros(frame.data, results, count);
+			
+#if RC_MAX_CHANNELS >= 18
+			results[Channels]     = (flags & Flag_Ch17) ? 2000 : 1000;
+			results[Channels + 1] = (flags & Flag_Ch18) ? 2000 : 1000;
+			count += 2;
+#endif
+			m_channels = count;
+			m_state = State_Stable;
+			updated = true;
+		}
+		
+		// hand the frames back to the interrupt routine
+		memoryBarrier();
+		m_tail = head;
+		
+		// the failsafe reads the live time, it mustn't depend on rc::tick being updated
+		m_lastFrameTime = millis();
+		return updated;
+	}
+	else if (m_state == State_Stable)
+	{
+		uint16_t delta = static_cast<uint16_t>(millis()) - m_lastFrameTime;
+		if (delta >= m_timeout)
+		{
+			// signal lost
+			RC_TRACE("lost signal");
+			m_state = State_Lost;
+		}
+	}
+	return false;
+}
+
+
+// Private functions
+
+void SBUSIn::endFrame()
+{
+	m_frames[m_head].sequence = m_sequence;
+	++m_sequence;
+	
+	// when the queue is full this frame is dropped, the next frame will overwrite it
+	uint8_t next = (m_head + 1) & (FrameCount - 1);
+	if (next != m_tail)
+	{
+		memoryBarrier(); // finish writing the frame before publishing it
+		m_head = next;
+	}
+}
+
+
+#ifdef RC_USE_UART
+void SBUSIn::isr(uint8_t p_byte, bool p_valid, void* p_user)
+{
+	reinterpret_cast<SBUSIn*>(p_user)->byteReceived(p_byte, p_valid);
+}
+#endif // RC_USE_UART
+
+
+// namespace end
+}
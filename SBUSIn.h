@@ -0,0 +1,142 @@
+#ifndef INC_RC_SBUSIN_H
+#define INC_RC_SBUSIN_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** SBUSIn.h
+** SBUS Input functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <rc_config.h>
+
+
+namespace rc
+{
+
+/*! 
+ *  \brief     Class to encapsulate SBUS Input functionality.
+ *  \details   This class decodes the SBUS signal of a receiver, 16 proportional and 2 digital channels
+ *             sent as 25 byte frames over a serial line at 100000 baud, 8 data bits, even parity, 2 stop bits.
+ *             Channels are written to the input channel buffer in microseconds, like PPMIn and ServoIn.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ *  \warning   The SBUS signal is inverted, it needs an inverter between the receiver and the RX pin (pin 0).
+ *  \warning   The UART can't be used by Serial at the same time.
+ */
+class SBUSIn
+{
+public:
+	/*! \brief Constructs a SBUSIn object.*/
+	SBUSIn();
+	
+	/*! \brief Starts receiving.
+	    \note Sets up the UART for SBUS and enables the receive interrupt if RC_USE_UART is defined.
+	    \note Uses Timer1 to find the gaps between frames.*/
+	void start();
+	
+	/*! \brief Stops receiving.*/
+	void stop();
+	
+	/*! \brief Sets minimum amount of time without signal after which the signal is considered lost.
+	    \param p_length Minimum timeout time in milliseconds.
+	    \note The timeout is checked against millis(), not rc::tick, so it works whether or not
+	           the sketch calls rc::tick::update().*/
+	void setTimeout(uint16_t p_length);
+	
+	/*! \brief Gets amount of time without signal after which the signal is considered lost.
+	    \return The minimum timeout time in milliseconds.*/
+	uint16_t getTimeout() const;
+	
+	/*! \brief Checks if the input signal is stable.
+	    \return Return true if a valid frame has been received recently. */
+	bool isStable() const;
+	
+	/*! \brief Checks if the input signal has been lost.
+	    \return Return true if the receiver is in failsafe or no frames have been received for a while. */
+	bool isLost() const;
+	
+	/*! \brief Gets the number of channels in the signal.
+	    \return The number of channels written to the input channel buffer, 0 until the first frame. */
+	uint8_t getChannels() const;
+	
+	/*! \brief Gets the number of frames the receiver reported as lost.
+	    \return Number of frames with the frame lost flag set since construction, wraps around after 65535.*/
+	uint16_t getLostFrames() const;
+	
+	/*! \brief Gets the number of frames which have been received but have not been passed on by update().
+	    \return Number of dropped frames since construction, wraps around after 65535.*/
+	uint16_t getDroppedFrames() const;
+	
+	/*! \brief Handles a received byte.
+	    \param p_byte The received byte.
+	    \param p_valid False if the UART reported a framing, parity or overrun error.
+	    \note Call this from your interrupt handler if you're handling interrupts yourself.*/
+	void byteReceived(uint8_t p_byte, bool p_valid = true);
+	
+	/*! \brief Updates the result buffer with the newest received frame.
+	    \return Whether the input channels have been updated.
+	    \note Call this often to detect loss of signal early.*/
+	bool update();
+	
+private:
+	enum
+	{
+		FrameCount = 4,  //!< Size of the frame queue, must be a power of 2.
+		DataSize   = 23, //!< Bytes between header and footer, 22 for channels, 1 for flags.
+		Channels   = 16  //!< Number of proportional channels.
+	};
+	
+	enum State
+	{
+		State_Startup, //!< Just started, no signal received yet.
+		State_Stable,  //!< Receiving valid frames.
+		State_Lost     //!< Receiver in failsafe, or no valid frames for a while.
+	};
+	
+	struct Frame
+	{
+		uint16_t sequence;       //!< Number of the frame, increases by one for every received frame.
+		uint8_t  data[DataSize]; //!< Frame without header and footer.
+	};
+	
+	/*! \brief Completes the frame being received and queues it, called from the interrupt routine.*/
+	void endFrame();
+	
+#ifdef RC_USE_UART
+	static void isr(uint8_t p_byte, bool p_valid, void* p_user);
+#endif
+	
+	State    m_state;    //!< Current state of input signal.
+	uint8_t  m_channels; //!< Number of channels written to the input channel buffer.
+	uint16_t m_timeout;  //!< Time in milliseconds without signal after which the signal is considered "lost".
+	
+	Frame            m_frames[FrameCount]; //!< Frame queue, the frame at m_head is being received.
+	volatile uint8_t m_head;               //!< Frame being received, only changed by the interrupt routine.
+	volatile uint8_t m_tail;               //!< Oldest unread frame, only changed by update().
+	uint16_t         m_sequence;           //!< Sequence number of the frame being received.
+	uint16_t         m_lastSequence;       //!< Sequence number of the last frame passed on by update().
+	uint16_t         m_dropped;            //!< Number of frames not passed on by update().
+	uint16_t         m_lost;               //!< Number of frames the receiver reported as lost.
+	uint8_t          m_idx;                //!< Current index in frame being received, 0 is the header.
+	
+	uint16_t m_lastFrameTime; //!< Last time a new frame has been found
+	uint16_t m_lastTime;      //!< Timer 1 count at the last received byte.
+};
+/** \example sbusin_example.pde
+ * This is an example of how to use the SBUSIn class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_SBUSIN_H
@@ -0,0 +1,189 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** SBUSOut.cpp
+** SBUS Output functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <outputchannel.h>
+#define RC_MODULE RC_MODULE_PPM
+#include <rc_debug_lib.h>
+#include <rc_uartint.h>
+#include <SBUSOut.h>
+#include <util.h>
+
+
+namespace rc
+{
+
+enum
+{
+	SBUS_BAUD   = 100000,
+	SBUS_HEADER = 0x0F,
+	SBUS_FOOTER = 0x00,
+	
+	Flag_Ch17     = 0x01, //!< Digital channel 17
+	Flag_Ch18     = 0x02, //!< Digital channel 18
+	Flag_Failsafe = 0x08  //!< Receiver is in failsafe
+};
+
+
+// Public functions
+
+SBUSOut::SBUSOut()
+:
+m_idx(FrameSize),
+m_failsafe(false),
+m_frameLength(14000),
+m_lastFrameTime(0)
+{
+	
+}
+
+
+void SBUSOut::start()
+{
+	RC_TRACE("start");
+	
+#ifdef RC_USE_UART
+	uartint::setTxHandler(SBUSOut::isr, this);
+#endif
+	
+	// 100000 baud, 8 data bits, even parity, 2 stop bits
+	uint16_t ubrr = (F_CPU / 16 / SBUS_BAUD) - 1;
+	UBRR0H = (ubrr >> 8) & 0x0F;
+	UBRR0L = ubrr & 0xFF;
+	UCSR0A = 0;
+	UCSR0C = _BV(UPM01) | _BV(USBS0) | _BV(UCSZ01) | _BV(UCSZ00);
+	UCSR0B |= _BV(TXEN0);
+	
+	// first frame goes out on the next update
+	m_idx = FrameSize;
+	m_lastFrameTime = micros() - m_frameLength;
+}
+
+
+void SBUSOut::stop()
+{
+	RC_TRACE("stop");
+	
+	// the transmitter finishes the byte it's sending before it stops
+	uint8_t oldSREG = SREG;
+	cli();
+	UCSR0B &= ~(_BV(TXEN0) | _BV(UDRIE0));
+	m_idx = FrameSize;
+	SREG = oldSREG;
+	
+#ifdef RC_USE_UART
+	uartint::setTxHandler(0);
+#endif
+}
+
+
+void SBUSOut::setFrameLength(uint16_t p_length)
+{
+	RC_TRACE("set frame length: %u us", p_length);
+	RC_ASSERT_MINMAX(p_length, 4000, 65535);
+	
+	m_frameLength = p_length;
+}
+
+
+uint16_t SBUSOut::getFrameLength() const
+{
+	return m_frameLength;
+}
+
+
+void SBUSOut::setFailsafe(bool p_failsafe)
+{
+	RC_TRACE("set failsafe: %d", p_failsafe);
+	m_failsafe = p_failsafe;
+}
+
+
+bool SBUSOut::getFailsafe() const
+{
+	return m_failsafe;
+}
+
+
+bool SBUSOut::update()
+{
+	if (m_idx < FrameSize || (UCSR0B & _BV(TXEN0)) == 0)
+	{
+		// still sending, or stopped
+		return false;
+	}
+	
+	uint32_t now = micros();
+	if (now - m_lastFrameTime < m_frameLength)
+	{
+		return false;
+	}
+	
+	// keep the frame rate, unless we're so late that a whole frame has been missed
+	m_lastFrameTime += m_frameLength;
+	if (now - m_lastFrameTime >= m_frameLength)
+	{
+		m_lastFrameTime = now;
+	}
+	
+	// 16 channels of 11 bits
+	const uint16_t* channels = getRawOutputChannels();
+	microsToPacked(channels, Channels < RC_MAX_CHANNELS ? Channels : RC_MAX_CHANNELS, m_frame + 1);
+	
+	uint8_t flags = m_failsafe ? Flag_Failsafe : 0;
+#if RC_MAX_CHANNELS >= 18
+	flags |= channels[Channels]     > 1500 ? Flag_Ch17 : 0;
+	flags |= channels[Channels + 1] > 1500 ? Flag_Ch18 : 0;
+#endif
+	m_frame[0] = SBUS_HEADER;
+	m_frame[FrameSize - 2] = flags;
+	m_frame[FrameSize - 1] = SBUS_FOOTER;
+	
+	// the interrupt routine takes it from here
+	m_idx = 0;
+	uint8_t oldSREG = SREG;
+	cli();
+	UCSR0B |= _BV(UDRIE0);
+	SREG = oldSREG;
+	return true;
+}
+
+
+void SBUSOut::dataRegisterEmpty()
+{
+	if (m_idx < FrameSize)
+	{
+		UDR0 = m_frame[m_idx];
+		++m_idx;
+	}
+	if (m_idx >= FrameSize)
+	{
+		// the last byte is on its way, nothing more to send
+		UCSR0B &= ~_BV(UDRIE0);
+	}
+}
+
+
+// Private functions
+
+#ifdef RC_USE_UART
+void SBUSOut::isr(void* p_user)
+{
+	reinterpret_cast<SBUSOut*>(p_user)->dataRegisterEmpty();
+}
+#endif // RC_USE_UART
+
+
+// namespace end
+}
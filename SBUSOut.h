@@ -0,0 +1,102 @@
+#ifndef INC_RC_SBUSOUT_H
+#define INC_RC_SBUSOUT_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** SBUSOut.h
+** SBUS Output functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+#include <rc_config.h>
+
+
+namespace rc
+{
+
+/*! 
+ *  \brief     Class to encapsulate SBUS Output functionality.
+ *  \details   This class sends the output channels as SBUS frames, 16 proportional and 2 digital channels
+ *             in 25 bytes over a serial line at 100000 baud, 8 data bits, even parity, 2 stop bits.
+ *             The UART sends the frame from a buffer, which takes one interrupt per byte,
+ *             where PPMOut takes two per channel.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+ *  \warning   The SBUS signal is inverted, it needs an inverter between the TX pin (pin 1) and the receiving end.
+ *  \warning   The UART can't be used by Serial at the same time.
+ */
+class SBUSOut
+{
+public:
+	/*! \brief Constructs a SBUSOut object.*/
+	SBUSOut();
+	
+	/*! \brief Sets up the UART for SBUS.
+	    \note Enables the transmitter, the first frame is sent by the next call to update().
+	    \note Uses the data register empty interrupt handler if RC_USE_UART is defined.*/
+	void start();
+	
+	/*! \brief Stops sending, the byte being sent is finished.*/
+	void stop();
+	
+	/*! \brief Sets the time between the start of two frames.
+	    \param p_length Frame length in microseconds, range [4000 - 65535], 14000 (default) or 7000 for high speed.
+	    \note A frame takes 3000 microseconds to send, receivers need a gap of at least 1000 microseconds.*/
+	void setFrameLength(uint16_t p_length);
+	
+	/*! \brief Gets the time between the start of two frames.
+	    \return Frame length in microseconds.*/
+	uint16_t getFrameLength() const;
+	
+	/*! \brief Sets the failsafe flag of the frames.
+	    \param p_failsafe Whether the receiving end should go to failsafe.*/
+	void setFailsafe(bool p_failsafe);
+	
+	/*! \brief Gets the failsafe flag of the frames.
+	    \return Whether the failsafe flag is set.*/
+	bool getFailsafe() const;
+	
+	/*! \brief Starts sending a frame with the current output channels if the next frame is due.
+	    \return Whether a frame has been started.
+	    \note Channels are read only when a frame is started, call this often.
+	    \note Channels 1 - 16 are sent in microseconds [880 - 2159], channels 17 and 18 are on above 1500 microseconds.*/
+	bool update();
+	
+	/*! \brief Sends the next byte of the frame.
+	    \note Call this from your USART_UDRE interrupt handler if you're handling interrupts yourself.*/
+	void dataRegisterEmpty();
+	
+private:
+	enum
+	{
+		FrameSize = 25, //!< Header, 22 bytes of channels, flags and footer.
+		Channels  = 16  //!< Number of proportional channels.
+	};
+	
+#ifdef RC_USE_UART
+	static void isr(void* p_user);
+#endif
+	
+	uint8_t          m_frame[FrameSize]; //!< Frame being sent.
+	volatile uint8_t m_idx;              //!< Next byte to send, FrameSize when done.
+	bool             m_failsafe;         //!< Whether the failsafe flag is set.
+	uint16_t         m_frameLength;      //!< Time between frames in microseconds.
+	uint32_t         m_lastFrameTime;    //!< Time at which the last frame was started in microseconds.
+};
+/** \example sbusout_example.pde
+ * This is an example of how to use the SBUSOut class.
+ */
+
+
+} // namespace end
+
+#endif // INC_RC_SBUSOUT_H
@@ -14,10 +14,12 @@
 #include <Arduino.h>
 
 #include <inputchannel.h>
+#define RC_MODULE RC_MODULE_SERVO
 #include <rc_debug_lib.h>
 #include <ServoIn.h>
 #include <Timer1.h>
 #include <rc_pcint.h>
+#include <util.h>
 
 
 namespace rc
@@ -29,7 +31,7 @@ ServoIn::ServoIn()
 :
 m_high(true)
 {
-	
+	resetStats();
 }
 
 
@@ -78,13 +80,12 @@ void ServoIn::start(bool p_high)
 	rc::Timer1::start();
 	
 #ifdef RC_USE_PCINT
-	// register pin change interrupts
-	m_lastPin = 0;
+	// register pin change interrupts, let pcint tell us which servo changed
 	for (uint8_t i = 0; i < RC_MAX_CHANNELS; ++i)
 	{
 		if (m_pins[i] != 0)
 		{
-			pcint::enable(m_pins[i], ServoIn::isr, this);
+			pcint::enable(m_pins[i], ServoIn::isr, this, i);
 		}
 	}
 #endif // RC_USE_PCINT
@@ -93,8 +94,7 @@ void ServoIn::start(bool p_high)
 
 void ServoIn::stop()
 {
-	// stop Timer 1
-	rc::Timer1::stop();
+	// Timer 1 keeps running, PPMOut or ServoOut may be using it
 	
 #ifdef RC_USE_PCINT
 	// unregister pin change interrupts
@@ -109,7 +109,6 @@ void ServoIn::stop()
 }
 
 
-#ifndef RC_USE_PCINT
 void ServoIn::pinChanged(uint8_t p_servo, bool p_high)
 {
 	// first things first, get Timer 1 count
@@ -120,76 +119,70 @@ void ServoIn::pinChanged(uint8_t p_servo, bool p_high)
 	
 	if (p_high == m_high)
 	{
+		// time since the start of the previous pulse, in Timer 1 ticks of half a microsecond
+		if (m_pulseStart[p_servo] != 0)
+		{
+			uint16_t gap = (cnt - m_pulseStart[p_servo]) >> 1;
+			if (gap > m_stats.maxGap)
+			{
+				m_stats.maxGap = gap;
+			}
+		}
+		
 		// start of pulse, cheat half a microsecond so we can detect errors
 		m_pulseStart[p_servo] = (cnt == 0) ? 1 : cnt;
 	}
 	else
 	{
 		// end of pulse, clear length on error
-		m_pulseLength[p_servo] = (m_pulseStart[p_servo] == 0) ? 0 : (cnt - m_pulseStart[p_servo]);
+		if (m_pulseStart[p_servo] == 0)
+		{
+			m_pulseLength[p_servo] = 0;
+			++m_stats.confused;
+		}
+		else
+		{
+			m_pulseLength[p_servo] = cnt - m_pulseStart[p_servo];
+			++m_stats.frames;
+		}
 	}
 }
-#endif // NOT RC_USE_PCINT
 
 
 void ServoIn::update()
 {
-	uint16_t* results = getRawInputChannels();
-	for (uint8_t i = 0; i < RC_MAX_CHANNELS; ++i)
-	{
-		results[i] = m_pulseLength[i] >> 1;
-	}
+	ticksToMicros(m_pulseLength, getRawInputChannels(), RC_MAX_CHANNELS);
 }
 
 
-// private functions
+void ServoIn::getStats(InputStats& p_stats) const
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	p_stats = m_stats;
+	SREG = oldSREG;
+}
 
-#ifdef RC_USE_PCINT
-void ServoIn::pinChanged(uint8_t p_pin, bool p_high)
+
+void ServoIn::resetStats()
 {
-	// first things first, get Timer 1 count
 	uint8_t oldSREG = SREG;
 	cli();
-	uint16_t cnt = TCNT1;
+	m_stats.frames         = 0;
+	m_stats.confused       = 0;
+	m_stats.timeouts       = 0;
+	m_stats.channelChanges = 0;
+	m_stats.maxGap         = 0;
 	SREG = oldSREG;
-	
-	// find the servo
-	uint8_t servo = m_lastPin;
-	for (;;)
-	{
-		if (m_pins[servo] == p_pin)
-		{
-			break;
-		}
-		++servo;
-		if (servo >= RC_MAX_CHANNELS)
-		{
-			servo = 0;
-		}
-		if (servo == m_lastPin)
-		{
-			// pin not found
-			return;
-		}
-	}
-	
-	if (p_high == m_high)
-	{
-		// start of pulse, cheat half a microsecond so we can detect errors
-		m_pulseStart[servo] = (cnt == 0) ? 1 : cnt;
-	}
-	else
-	{
-		// end of pulse, clear length on error
-		m_pulseLength[servo] = (m_pulseStart[servo] == 0) ? 0 : (cnt - m_pulseStart[servo]);
-		m_lastPin = servo;
-	}
 }
 
 
-void ServoIn::isr(uint8_t p_pin, bool p_high, void* p_user)
+// private functions
+
+#ifdef RC_USE_PCINT
+void ServoIn::isr(uint8_t p_servo, bool p_high, void* p_user)
 {
-	reinterpret_cast<ServoIn*>(p_user)->pinChanged(p_pin, p_high);
+	reinterpret_cast<ServoIn*>(p_user)->pinChanged(p_servo, p_high);
 }
 #endif // RC_USE_PCINT
 
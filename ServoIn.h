@@ -17,6 +17,7 @@
 #include <inttypes.h>
 #include <avr/pgmspace.h>
 
+#include <inputchannel.h>
 #include <rc_config.h>
 
 
@@ -80,17 +81,26 @@ public:
 	/*! \brief Updates output buffer with new values.*/
 	void update();
 	
+	/*! \brief Gets statistics about the quality of the signals of all servos.
+	    \param p_stats Copy of the statistics, consistent since it's taken with interrupts disabled.
+	    \note Pulses ending without a start count as confused. The gap is measured between the starts
+	           of two pulses of one servo, gaps over 32 ms can't be told apart from shorter ones.*/
+	void getStats(InputStats& p_stats) const;
+	
+	/*! \brief Resets all statistics to 0.*/
+	void resetStats();
+	
 private:
 #ifdef RC_USE_PCINT
-	void pinChanged(uint8_t p_pin, bool p_high); //!< Internal pin change interrupt handler
-	static void isr(uint8_t p_pin, bool p_high, void* p_user); //!< ISR
+	void pinChanged(uint8_t p_servo, bool p_high); //!< Internal pin change interrupt handler
+	static void isr(uint8_t p_servo, bool p_high, void* p_user); //!< ISR, pcint passes the servo instead of the pin
 #endif
 	
 	bool     m_high;                         //!< Whether pulses are high or low.
 	uint16_t m_pulseStart[RC_MAX_CHANNELS];  //!< Last measured pulse start for each servo.
 	uint16_t m_pulseLength[RC_MAX_CHANNELS]; //!< Last measured pulse length for each servo.
+	InputStats m_stats;                      //!< Signal statistics, kept by the interrupt routine.
 #ifdef RC_USE_PCINT
-	uint8_t  m_lastPin;               //!< Last pin that was active.
 	uint8_t  m_pins[RC_MAX_CHANNELS]; //!< List of pins to read from.
 #endif
 };
@@ -14,6 +14,7 @@
 #include <Arduino.h>
 
 #include <outputchannel.h>
+#define RC_MODULE RC_MODULE_SERVO
 #include <rc_debug_lib.h>
 #include <ServoOut.h>
 #include <Timer1.h>
@@ -22,6 +23,13 @@
 namespace rc
 {
 
+enum
+{
+	MinDelay = 32,   //!< Timer ticks the interrupt routine needs before it can handle the next event.
+	MaxMergeWindow = 32, //!< Longest merge window in microseconds.
+	IdleDelay = 20000 //!< Timer ticks between checks for a new frame when there's nothing to send.
+};
+
 ServoOut* ServoOut::s_instance = 0;
 
 
@@ -30,12 +38,15 @@ ServoOut* ServoOut::s_instance = 0;
 ServoOut::ServoOut(const uint8_t* p_pins)
 :
 m_pauseLength(10000),
+m_bankSize(1),
+m_mergeWindow(0),
 m_pins(p_pins),
-m_activePort(0),
-m_activeMask(0),
-m_nextPort(0),
-m_nextMask(0),
-m_idx(0)
+m_active(m_frames),
+m_back(m_frames + 1),
+m_newFrame(false),
+m_eventPos(0),
+m_compare(Timer1::Compare_None),
+m_ocr(0)
 {
 	s_instance = this;
 }
@@ -44,23 +55,52 @@ m_idx(0)
 void ServoOut::start()
 {
 	RC_TRACE("start");
-	// set initial values
-	update(true);
 	
-	// stop timer 1
-	rc::Timer1::stop();
+	// release the compare unit of a previous start, Timer1 itself keeps running for its other users
+	stop();
 	
-	// disable compare match B interrupts
-	rc::Timer1::setCompareMatch(false, false);
+	// set initial values, the interrupt is off so the new frame can be made active right away
+	update(true);
+	Frame* frame = m_active;
+	m_active = m_back;
+	m_back = frame;
+	m_newFrame = false;
+	m_eventPos = 0;
 	
-	// set compare value (first, we wait)
-	OCR1B = TCNT1 + (m_pauseLength << 1);
+	// start the timer if nobody did yet
+	rc::Timer1::start();
 	
-	// enable timer output compare match B interrupts
-	rc::Timer1::setCompareMatch(true, false, ServoOut::handleInterrupt);
+	// claim a compare unit, first we wait
+	m_compare = rc::Timer1::claimCompare(ServoOut::handleInterrupt, m_pauseLength << 1);
+	if (m_compare == Timer1::Compare_None)
+	{
+		RC_ERROR("no compare unit");
+		return;
+	}
+	m_ocr = rc::Timer1::getCompareRegister(m_compare);
+}
+
+
+void ServoOut::stop()
+{
+	RC_TRACE("stop");
 	
-	// start the timer
-	rc::Timer1::start();
+	// the interrupt toggles the pins, so leave them low or the next start sends inverted pulses
+	uint8_t oldSREG = SREG;
+	cli();
+	rc::Timer1::releaseCompare(m_compare);
+	if (m_compare != Timer1::Compare_None)
+	{
+		for (uint8_t i = 0; i < RC_SERVOOUT_MAX_SERVOS; ++i)
+		{
+			if (m_pins[i] != 0)
+			{
+				*portOutputRegister(digitalPinToPort(m_pins[i])) &= ~digitalPinToBitMask(m_pins[i]);
+			}
+		}
+	}
+	m_compare = Timer1::Compare_None;
+	SREG = oldSREG;
 }
 
 
@@ -79,71 +119,214 @@ uint16_t ServoOut::getPauseLength() const
 }
 
 
+Timer1::Compare ServoOut::getCompare() const
+{
+	return m_compare;
+}
+
+
+void ServoOut::setBankSize(uint8_t p_size)
+{
+	RC_TRACE("set bank size: %u", p_size);
+	RC_ASSERT_MINMAX(p_size, 1, 8);
+	
+	m_bankSize = p_size;
+}
+
+
+uint8_t ServoOut::getBankSize() const
+{
+	return m_bankSize;
+}
+
+
+void ServoOut::setMergeWindow(uint8_t p_length)
+{
+	RC_TRACE("set merge window: %u us", p_length);
+	RC_ASSERT_MINMAX(p_length, 0, MaxMergeWindow);
+	
+	m_mergeWindow = p_length > MaxMergeWindow ? MaxMergeWindow : p_length;
+}
+
+
+uint8_t ServoOut::getMergeWindow() const
+{
+	return m_mergeWindow;
+}
+
+
 void ServoOut::update(bool p_pinsChanged)
 {
-	uint16_t remainingTime = m_pauseLength;
-	uint8_t idx = 0;
+	if (p_pinsChanged)
+	{
+		for (uint8_t i = 0; i < RC_SERVOOUT_MAX_SERVOS; ++i)
+		{
+			if (m_pins[i] != 0)
+			{
+				m_masks[i] = digitalPinToBitMask(m_pins[i]);
+				m_ports[i] = portInputRegister(digitalPinToPort(m_pins[i]));
+			}
+		}
+	}
 	
+	// take back a frame that hasn't been sent yet, the interrupt routine won't swap while we're busy
+	uint8_t oldSREG = SREG;
+	cli();
+	m_newFrame = false;
+	Frame* frame = m_back;
+	SREG = oldSREG;
+	
+	updateEvents(frame);
+	
+	// hand the frame to the interrupt routine, it will be sent after the current one
+	oldSREG = SREG;
+	cli();
+	m_newFrame = true;
+	SREG = oldSREG;
+}
+
+
+void ServoOut::handleInterrupt()
+{
+	if (s_instance != 0)
+	{
+		s_instance->isr();
+	}
+}
+
+
+// Private functions
+
+void ServoOut::updateEvents(Frame* p_frame)
+{
 	const uint16_t* values = getRawOutputChannels();
-	for (uint8_t i = 0; i < RC_MAX_CHANNELS; ++i)
+	Event*   event  = p_frame->events;
+	uint32_t length = 0; // length of all banks in timer ticks
+	uint16_t window = static_cast<uint16_t>(m_mergeWindow) << 1;
+	if (window < MinDelay)
 	{
-		if (m_pins[i] != 0 && values[i] != 0)
+		window = MinDelay;
+	}
+	
+	uint8_t i = 0;
+	while (i < RC_SERVOOUT_MAX_SERVOS)
+	{
+		if (m_pins[i] == 0 || values[i] == 0)
 		{
-			if (p_pinsChanged)
+			++i;
+			continue;
+		}
+		
+		// a bank starts with all of its pins at once
+		Event* start = event;
+		start->port = m_ports[i];
+		start->mask = 0;
+		++event;
+		
+		// followed by the end of each pulse, sorted by time, delay holds the time for now
+		Event*  first = event;
+		uint8_t size  = 0;
+		for (; i < RC_SERVOOUT_MAX_SERVOS && size < m_bankSize; ++i)
+		{
+			if (m_pins[i] == 0 || values[i] == 0)
 			{
-				uint8_t mask = digitalPinToBitMask(m_pins[i]);
-				uint8_t port = digitalPinToPort(m_pins[i]);
-				volatile uint8_t* out = portInputRegister(port);
-				
-				RC_ASSERT_MINMAX(values[i], 0, 32766);
-				
-				TIMSK1 &= ~(1 << OCIE1B);
-				m_timings[idx] = values[i] << 1;
-				m_ports[idx] = static_cast<uint8_t>(reinterpret_cast<uint16_t>(out) & 0xFF);
-				m_masks[idx] = mask;
-				TIMSK1 |= (1 << OCIE1B);
+				continue;
 			}
-			else
+			if (m_ports[i] != start->port)
 			{
-				RC_ASSERT_MINMAX(values[i], 0, 32766);
-				
-				TIMSK1 &= ~(1 << OCIE1B);
-				m_timings[idx] = values[i] << 1;
-				TIMSK1 |= (1 << OCIE1B);
+				break;
 			}
 			
-			if (remainingTime < values[i])
+			RC_ASSERT_MINMAX(values[i], 0, 32766);
+			uint16_t time = values[i] << 1;
+			
+			Event* pos = event;
+			while (pos != first && (pos - 1)->delay > time)
 			{
-				remainingTime = 0;
+				*pos = *(pos - 1);
+				--pos;
 			}
-			else
+			pos->port  = m_ports[i];
+			pos->mask  = m_masks[i];
+			pos->delay = time;
+			
+			start->mask |= m_masks[i];
+			++event;
+			++size;
+		}
+		
+		// turn times into delays, pulses ending within the window after the first one of a group
+		// end together halfway between the first and the last end, so none of them is more than
+		// half the window early or late. A group never follows the previous event sooner than
+		// the interrupt routine can handle, which keeps the error within half of MinDelay.
+		Event*   previous = start;
+		uint16_t now      = 0;
+		for (Event* pos = first; pos != event; ++pos)
+		{
+			uint16_t from = pos->delay;
+			Event*   last = pos;
+			while (last + 1 != event && static_cast<uint16_t>((last + 1)->delay - from) < window)
 			{
-				remainingTime -= values[i];
+				++last;
 			}
 			
-			++idx;
+			uint16_t time = from + ((last->delay - from) >> 1);
+			if (static_cast<uint16_t>(time - now) < MinDelay)
+			{
+				time = now + MinDelay;
+			}
+			previous->delay = time - now;
+			for (; pos != last; ++pos)
+			{
+				pos->delay = 0;
+			}
+			previous = last;
+			now = time;
 		}
+		
+		// the next bank starts right away
+		previous->delay = 0;
+		length += now;
 	}
 	
-	TIMSK1 &= ~(1 << OCIE1B);
-	m_timings[idx] = remainingTime << 1;
-	m_ports[idx] = 0;
-	m_masks[idx] = 0;
-	TIMSK1 = (1 << OCIE1B);
-}
-
-
-void ServoOut::handleInterrupt()
-{
-	if (s_instance != 0)
+	// events at the same time on the same port become a single write, so no pin is
+	// toggled a moment after the others. A pin toggled twice isn't toggled at all.
+	Event* end   = event;
+	Event* group = p_frame->events;
+	event = p_frame->events;
+	for (Event* pos = p_frame->events; pos != end; ++pos)
 	{
-		s_instance->isr();
+		Event* same = group;
+		while (same != event && same->port != pos->port)
+		{
+			++same;
+		}
+		if (same != event)
+		{
+			same->mask ^= pos->mask;
+			(event - 1)->delay = pos->delay;
+		}
+		else
+		{
+			*event = *pos;
+			++event;
+		}
+		if (pos->delay != 0)
+		{
+			group = event;
+		}
+	}
+	
+	p_frame->count = event - p_frame->events;
+	if (p_frame->count != 0)
+	{
+		// the last pulse is followed by the pause
+		uint32_t frame = static_cast<uint32_t>(m_pauseLength) << 1;
+		(event - 1)->delay = frame > length + MinDelay ? frame - length : MinDelay;
 	}
 }
 
 
-// Private functions
-
 void ServoOut::isr()
 {
 	// Interrupt Service Routine
@@ -151,34 +334,42 @@ void ServoOut::isr()
 	// But above all, the time spend between the start of the interrupt and the changing of pin values should be
 	// as constant as possible, to get the most accurate timings possible.
 	
-	if (m_activePort != 0)
-	{
-		// toggle active port (turn it off)
-		*m_activePort |= m_activeMask;
-	}
-	if (m_nextPort != 0)
+	uint16_t delay;
+	do
 	{
-		// toggle new port (turn it on)
-		*m_nextPort |= m_nextMask;
+		if (m_active->count == 0)
+		{
+			// nothing to send, wait for a frame
+			delay = IdleDelay;
+		}
+		else
+		{
+			// writing ones to the input register toggles only those pins,
+			// other pins on the port may be in the middle of their pulse
+			const Event& event = m_active->events[m_eventPos];
+			*event.port = event.mask;
+			delay = event.delay;
+			++m_eventPos;
+		}
+		
+		if (m_eventPos >= m_active->count)
+		{
+			m_eventPos = 0;
+			
+			// we're at the end of frame here, switch to the new frame if there is one
+			if (m_newFrame)
+			{
+				Frame* frame = m_active;
+				m_active = m_back;
+				m_back = frame;
+				m_newFrame = false;
+			}
+		}
 	}
+	while (delay == 0);
 	
 	// update compare register
-	OCR1B += m_timings[m_idx];
-	
-	// update active
-	m_activePort = m_nextPort;
-	m_activeMask = m_nextMask;
-	
-	// update index
-	++m_idx;
-	if (m_idx > RC_MAX_CHANNELS || m_timings[m_idx] == 0)
-	{
-		m_idx = 0;
-	}
-	
-	// get next port and mask
-	m_nextPort = reinterpret_cast<volatile uint8_t*>(m_ports[m_idx]);
-	m_nextMask = m_masks[m_idx];
+	*m_ocr += delay;
 }
 
 
@@ -17,6 +17,7 @@
 #include <inttypes.h>
 
 #include <rc_config.h>
+#include <Timer1.h>
 
 
 namespace rc
@@ -25,6 +26,9 @@ namespace rc
 /*! 
  *  \brief     Class to encapsulate Servo Signal Output functionality.
  *  \details   This class provides a way to generate a Servo signal.
+ *             Frames are double buffered, which takes 23 bytes of RAM per servo on AVR,
+ *             about 420 bytes for 18 servos. Set RC_SERVOOUT_MAX_SERVOS in rc_config.h
+ *             to the number of servos you use to reduce this.
  *  \author    Daniel van den Ouden
  *  \date      Feb-2012
  *  \warning   This class should <b>NOT</b> be used together with the standard Arduino Servo library.
@@ -35,45 +39,115 @@ class ServoOut
 public:
 	
 	/*! \brief Constructs a ServoOut object.
-	    \param p_pins Input buffer of pins to connect servos to.*/
+	    \param p_pins Input buffer of pins to connect servos to, RC_MAX_CHANNELS in size.
+	                  Only the first RC_SERVOOUT_MAX_SERVOS pins are used, 0 for no servo.*/
 	ServoOut(const uint8_t* p_pins);
 	
-	/*! \brief Starts timers and output.*/
+	/*! \brief Starts timers and output.
+	    \details Claims a compare unit of Timer1, B unless PPMOut already has it.*/
 	void start();
 	
+	/*! \brief Stops output and releases the compare unit, Timer1 keeps running.
+	    \note A pulse in progress is cut short, all pins are driven low.*/
+	void stop();
+	
 	/*! \brief Sets the minimum length between pulses on a pin.
-	    \param p_length The minimum length between two pulses in microseconds.*/
+	    \param p_length The minimum length between two pulses in microseconds.
+	    \details This is the length of a frame, unless the pulses take longer than that.
+	              With banks of servos 3000 gives a refresh rate of 333 Hz.*/
 	void setPauseLength(uint16_t p_length);
 	
 	/*! \brief Gets the minimum length between pulses on a pin.
 	    \return The minimum length between two pulses in microseconds.*/
 	uint16_t getPauseLength() const;
 	
+	/*! \brief Gets the compare unit claimed from Timer1.
+	    \return The compare unit, Compare_None when not started.*/
+	Timer1::Compare getCompare() const;
+	
+	/*! \brief Sets the number of servos which get their pulse at the same time.
+	    \param p_size Maximum number of servos in a bank, range [1 - 8].
+	    \details Consecutive channels with pins on the same port form a bank, all servos
+	              of a bank start their pulse together and each one ends at its own time.
+	              A bank takes as long as its longest pulse, so 8 servos on port D take 2 ms
+	              instead of 16 ms, fast enough for digital servos and ESCs at 200 - 333 Hz.
+	              With the default of 1 the servos get their pulses one after the other.
+	    \note Takes effect on the next call to update().*/
+	void setBankSize(uint8_t p_size);
+	
+	/*! \brief Gets the number of servos which get their pulse at the same time.
+	    \return Maximum number of servos in a bank, range [1 - 8].*/
+	uint8_t getBankSize() const;
+	
+	/*! \brief Sets the window in which pulses of a bank end together.
+	    \param p_length Window length in microseconds, range [0 - 32].
+	    \details Pulses of a bank ending less than this after the first of them end together,
+	              halfway between the first and the last end, pins on the same port are toggled
+	              by a single write. This takes fewer interrupts per frame, at the cost of pulses
+	              ending up to half the window early or late. The window is never shorter than the
+	              16 microseconds the interrupt routine needs, so with the default of 0 pulses
+	              are off by at most 8 microseconds.
+	    \note Takes effect on the next call to update().*/
+	void setMergeWindow(uint8_t p_length);
+	
+	/*! \brief Gets the window in which pulses of a bank end together.
+	    \return Window length in microseconds, range [0 - 32].*/
+	uint8_t getMergeWindow() const;
+	
 	/*! \brief Updates all internal timings.
-	    \param p_pinsChanged If any pins have changed, set this to true.*/
+	    \param p_pinsChanged If any pins have changed, set this to true.
+	    \details Builds a complete frame in the back buffer, the interrupt routine
+	              switches to it at the end of the frame it is sending.*/
 	void update(bool p_pinsChanged = false);
 	
 	/*! \brief Handles timer interrupt.*/
 	static void handleInterrupt();
 	
 private:
+	enum
+	{
+		MaxEvents = RC_SERVOOUT_MAX_SERVOS * 2 //!< The start of every bank and the end of every pulse.
+	};
+	
+	/*! \brief Pins toggled at the same time.*/
+	struct Event
+	{
+		volatile uint8_t* port;  //!< Input register of the port, writing a one toggles a pin.
+		uint8_t           mask;  //!< Pins to toggle.
+		uint16_t          delay; //!< Timer ticks until the next event, 0 for right away.
+	};
+	
+	/*! \brief A complete frame of pulses.*/
+	struct Frame
+	{
+		uint8_t count;             //!< Number of events.
+		Event   events[MaxEvents]; //!< Events in order of time.
+	};
+	
+	/*! \brief Fills a frame with the events of all pulses.
+	    \param p_frame Frame to fill, may not be in use by the interrupt routine.*/
+	void updateEvents(Frame* p_frame);
+	
 	/*! \brief Internal interrupt handling. */
 	void isr();
 	
 	uint16_t m_pauseLength; //!< Minimal length of pause between pulses on a pin in microseconds.
+	uint8_t  m_bankSize;    //!< Maximum number of servos in a bank.
+	uint8_t  m_mergeWindow; //!< Window in which pulses end together in microseconds.
 	
 	const uint8_t* m_pins;   //!< External buffer defining pins to use.
 	
-	volatile uint16_t m_timings[RC_MAX_CHANNELS]; //!< Work buffer containing timings.
-	volatile uint8_t  m_ports[RC_MAX_CHANNELS];   //!< Work buffer containing port addresses.
-	volatile uint8_t  m_masks[RC_MAX_CHANNELS];   //!< Work buffer containing bitmasks.
+	volatile uint8_t* m_ports[RC_SERVOOUT_MAX_SERVOS]; //!< Input registers of the ports of the pins.
+	uint8_t           m_masks[RC_SERVOOUT_MAX_SERVOS]; //!< Bitmasks of the pins.
 	
-	volatile uint8_t* m_activePort; //!< Address of port of currently active (high) pin.
-	         uint8_t  m_activeMask; //!< Inverted bitmask of currently active (high) pin.
-	volatile uint8_t* m_nextPort;   //!< Address of port of next active (high) pin.
-	         uint8_t  m_nextMask;   //!< Bitmask of next active (high) pin.
+	Frame           m_frames[2]; //!< Frame being sent and frame being prepared.
+	Frame*          m_active;    //!< Frame being sent by the interrupt routine.
+	Frame* volatile m_back;      //!< Frame being prepared by update().
+	volatile bool   m_newFrame;  //!< Whether the back frame is ready to be sent.
+	uint8_t         m_eventPos;  //!< Next event in active frame.
 	
-	uint8_t m_idx; //!< Next index in work buffers.
+	Timer1::Compare    m_compare; //!< Compare unit claimed from Timer1.
+	volatile uint16_t* m_ocr;     //!< Compare register of the claimed unit.
 	
 	static ServoOut* s_instance; //!< Singleton instance.
 };
@@ -13,6 +13,7 @@
 
 #include <input.h>
 #include <output.h>
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
 #include <Swashplate.h>
 #include <util.h>
@@ -11,6 +11,7 @@
 ** Website: http://sourceforge.net/p/arduinorclib/
 ** -------------------------------------------------------------------------*/
 
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
 #include <ThrottleHold.h>
 
@@ -14,6 +14,7 @@
 #include <stdlib.h>
 
 #include <ThrottleMixBase.h>
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
 #include <util.h>
 
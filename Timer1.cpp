@@ -13,14 +13,18 @@
 
 #include <Arduino.h>
 
+#define RC_MODULE RC_MODULE_IO
 #include <rc_debug_lib.h>
 #include <Timer1.h>
 
 
-// Static variables
-static rc::Timer1::Callback s_TOIE1Callback = 0;
-static rc::Timer1::Callback s_OCI1ACallback = 0;
-static rc::Timer1::Callback s_OCI1BCallback = 0;
+// Static variables, a callback is written a byte at a time so only change them with interrupts off
+static rc::Timer1::Callback volatile s_TOIE1Callback = 0;
+static rc::Timer1::Callback volatile s_OCI1ACallback = 0;
+static rc::Timer1::Callback volatile s_OCI1BCallback = 0;
+static rc::Timer1::Callback volatile s_ICP1Callback  = 0;
+static rc::Timer1::Callback volatile s_overflowHooks[RC_TIMER1_OVERFLOW_HOOKS] = { 0 };
+static volatile uint16_t    s_overflows = 0; //!< High word of the 32 bit time
 bool s_debug = false;
 
 namespace rc
@@ -39,6 +43,7 @@ void Timer1::init(bool p_debug)
 	OCR1A = 0;
 	OCR1B = 0;
 	TCNT1 = 0;
+	s_overflows = 0;
 }
 
 
@@ -46,7 +51,13 @@ void Timer1::start()
 {
 	RC_TRACE("start");
 	TCCR1B = (TCCR1B & ~(_BV(CS12) | _BV(CS11) | _BV(CS10))) |
-	         s_debug ? (_BV(CS12) | _BV(CS10)) :  _BV(CS11);
+	         (s_debug ? (_BV(CS12) | _BV(CS10)) :  _BV(CS11));
+	
+	// count overflows for the 32 bit time, TOP isn't 0xFFFF in Fast PWM mode
+	if ((TCCR1B & _BV(WGM13)) == 0)
+	{
+		TIMSK1 |= _BV(TOIE1);
+	}
 }
 
 
@@ -63,9 +74,130 @@ void Timer1::stop()
 }
 
 
+uint32_t Timer1::getTime()
+{
+	// TCNT1 is read through a temporary register shared with the interrupt routines
+	uint8_t oldSREG = SREG;
+	cli();
+	uint16_t cnt  = TCNT1;
+	uint16_t high = s_overflows;
+	
+	// an overflow which hasn't been handled yet, a low count means it came before we read it
+	if ((TIFR1 & _BV(TOV1)) && cnt < 0x8000)
+	{
+		++high;
+	}
+	SREG = oldSREG;
+	
+	return (static_cast<uint32_t>(high) << 16) | cnt;
+}
+
+
+bool Timer1::isClaimed()
+{
+	if (TIMSK1 & (_BV(OCIE1A) | _BV(OCIE1B) | _BV(ICIE1)))
+	{
+		return true;
+	}
+	if (s_TOIE1Callback != 0)
+	{
+		return true;
+	}
+	for (uint8_t i = 0; i < RC_TIMER1_OVERFLOW_HOOKS; ++i)
+	{
+		if (s_overflowHooks[i] != 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+Timer1::Compare Timer1::claimCompare(Callback p_callback, uint16_t p_delay, Compare p_compare)
+{
+	RC_TRACE("claim compare: %d delay: %u Callback: %p", p_compare, p_delay, p_callback);
+	if (isFastPWM())
+	{
+		// the counter doesn't run freely, so a delay from now means nothing
+		RC_WARN("Timer1 is in Fast PWM mode");
+		return Compare_None;
+	}
+	if (p_compare == Compare_None)
+	{
+		// OC1A (pin 9) is the usual PPM output pin, so hand out B first
+		if ((TIMSK1 & _BV(OCIE1B)) == 0)
+		{
+			p_compare = Compare_B;
+		}
+		else if ((TIMSK1 & _BV(OCIE1A)) == 0)
+		{
+			p_compare = Compare_A;
+		}
+		else
+		{
+			RC_WARN("no free compare unit");
+			return Compare_None;
+		}
+	}
+	else if (TIMSK1 & (p_compare == Compare_A ? _BV(OCIE1A) : _BV(OCIE1B)))
+	{
+		RC_WARN("compare unit %d is taken", p_compare);
+		return Compare_None;
+	}
+	
+	// set the first match and forget any match from before we claimed it
+	uint8_t oldSREG = SREG;
+	cli();
+	*getCompareRegister(p_compare) = TCNT1 + p_delay;
+	TIFR1 = p_compare == Compare_A ? _BV(OCF1A) : _BV(OCF1B);
+	setCompareMatch(true, p_compare == Compare_A, p_callback);
+	SREG = oldSREG;
+	
+	return p_compare;
+}
+
+
+void Timer1::releaseCompare(Compare p_compare)
+{
+	RC_TRACE("release compare: %d", p_compare);
+	if (p_compare == Compare_None)
+	{
+		return;
+	}
+	
+	bool    a   = p_compare == Compare_A;
+	uint8_t com = a ? (_BV(COM1A1) | _BV(COM1A0)) : (_BV(COM1B1) | _BV(COM1B0));
+	
+	uint8_t oldSREG = SREG;
+	cli();
+	bool toggling = (TCCR1A & com) != 0;
+	setCompareMatch(false, a);
+	setToggle(false, a);
+	if (toggling)
+	{
+		// the compare output keeps its level while disconnected, force it low
+		// so the next user doesn't start with an inverted pin
+		TCCR1A = (TCCR1A & ~com) | (a ? _BV(COM1A1) : _BV(COM1B1));
+		TCCR1C = a ? _BV(FOC1A) : _BV(FOC1B);
+		TCCR1A &= ~com;
+	}
+	SREG = oldSREG;
+}
+
+
+volatile uint16_t* Timer1::getCompareRegister(Compare p_compare)
+{
+	RC_ASSERT(p_compare != Compare_None);
+	return p_compare == Compare_A ? &OCR1A : &OCR1B;
+}
+
+
 void Timer1::setCompareMatch(bool p_enable, bool p_OCIE1A, Callback p_callback)
 {
 	RC_TRACE("set compare match enable: %d OCIE1A: %d Callback: %p", p_enable, p_OCIE1A, p_callback);
+	uint8_t oldSREG = SREG;
+	cli();
 	if (p_enable)
 	{
 		if (p_OCIE1A)
@@ -92,12 +224,15 @@ void Timer1::setCompareMatch(bool p_enable, bool p_OCIE1A, Callback p_callback)
 			s_OCI1BCallback = 0;
 		}
 	}
+	SREG = oldSREG;
 }
 
 
 void Timer1::setOverflow(bool p_enable, Callback p_callback)
 {
 	RC_TRACE("set overflow enable: %d Callback: %p", p_enable, p_callback);
+	uint8_t oldSREG = SREG;
+	cli();
 	if (p_enable)
 	{
 		s_TOIE1Callback = p_callback;
@@ -105,9 +240,51 @@ void Timer1::setOverflow(bool p_enable, Callback p_callback)
 	}
 	else
 	{
-		TIMSK1 &= ~_BV(TOIE1);
+		// keep counting overflows while running
+		if (isRunning() == false)
+		{
+			TIMSK1 &= ~_BV(TOIE1);
+		}
 		s_TOIE1Callback = 0;
 	}
+	SREG = oldSREG;
+}
+
+
+bool Timer1::addOverflowHook(Callback p_callback)
+{
+	RC_TRACE("add overflow hook Callback: %p", p_callback);
+	uint8_t oldSREG = SREG;
+	cli();
+	for (uint8_t i = 0; i < RC_TIMER1_OVERFLOW_HOOKS; ++i)
+	{
+		if (s_overflowHooks[i] == 0)
+		{
+			s_overflowHooks[i] = p_callback;
+			TIMSK1 |= _BV(TOIE1);
+			SREG = oldSREG;
+			return true;
+		}
+	}
+	SREG = oldSREG;
+	RC_WARN("no room for overflow hook");
+	return false;
+}
+
+
+void Timer1::removeOverflowHook(Callback p_callback)
+{
+	RC_TRACE("remove overflow hook Callback: %p", p_callback);
+	uint8_t oldSREG = SREG;
+	cli();
+	for (uint8_t i = 0; i < RC_TIMER1_OVERFLOW_HOOKS; ++i)
+	{
+		if (s_overflowHooks[i] == p_callback)
+		{
+			s_overflowHooks[i] = 0;
+		}
+	}
+	SREG = oldSREG;
 }
 
 
@@ -124,6 +301,69 @@ void Timer1::setToggle(bool p_enable, bool p_OC1A)
 	}
 }
 
+
+void Timer1::setFastPWM(bool p_enable, uint16_t p_top)
+{
+	RC_TRACE("set fast pwm enable: %d top: %u", p_enable, p_top);
+	if (p_enable)
+	{
+		// mode 14, Fast PWM with ICR1 as TOP, overflows no longer make up a time
+		TIMSK1 &= ~_BV(TOIE1);
+		ICR1 = p_top;
+		TCCR1A = (TCCR1A & ~_BV(WGM10)) | _BV(WGM11);
+		TCCR1B |= _BV(WGM13) | _BV(WGM12);
+	}
+	else
+	{
+		// mode 0, Normal
+		TCCR1A &= ~(_BV(WGM11) | _BV(WGM10));
+		TCCR1B &= ~(_BV(WGM13) | _BV(WGM12));
+	}
+}
+
+
+bool Timer1::isFastPWM()
+{
+	return (TCCR1B & _BV(WGM13)) != 0;
+}
+
+
+void Timer1::setPWM(bool p_enable, bool p_OC1A)
+{
+	RC_TRACE("set pwm enable: %d OC1A: %d", p_enable, p_OC1A);
+	
+	// clear OC1x on Compare Match, set at BOTTOM
+	uint8_t com = p_OC1A ? (_BV(COM1A1) | _BV(COM1A0)) : (_BV(COM1B1) | _BV(COM1B0));
+	if (p_enable)
+	{
+		TCCR1A = (TCCR1A & ~com) | (p_OC1A ? _BV(COM1A1) : _BV(COM1B1));
+	}
+	else
+	{
+		TCCR1A &= ~com;
+	}
+}
+
+
+void Timer1::setInputCapture(bool p_enable, bool p_rising, Callback p_callback)
+{
+	RC_TRACE("set input capture enable: %d rising: %d Callback: %p", p_enable, p_rising, p_callback);
+	uint8_t oldSREG = SREG;
+	cli();
+	if (p_enable)
+	{
+		s_ICP1Callback = p_callback;
+		TCCR1B = p_rising ? (TCCR1B | _BV(ICNC1) | _BV(ICES1)) : ((TCCR1B | _BV(ICNC1)) & ~_BV(ICES1));
+		TIMSK1 |= _BV(ICIE1);
+	}
+	else
+	{
+		TIMSK1 &= ~_BV(ICIE1);
+		s_ICP1Callback = 0;
+	}
+	SREG = oldSREG;
+}
+
 // namespace end
 }
 
@@ -132,26 +372,48 @@ void Timer1::setToggle(bool p_enable, bool p_OC1A)
 
 ISR(TIMER1_OVF_vect)
 {
-	if (s_TOIE1Callback != 0)
+	++s_overflows;
+	rc::Timer1::Callback callback = s_TOIE1Callback;
+	if (callback != 0)
+	{
+		callback();
+	}
+	for (uint8_t i = 0; i < RC_TIMER1_OVERFLOW_HOOKS; ++i)
+	{
+		callback = s_overflowHooks[i];
+		if (callback != 0)
+		{
+			callback();
+		}
+	}
+}
+
+
+ISR(TIMER1_CAPT_vect)
+{
+	rc::Timer1::Callback callback = s_ICP1Callback;
+	if (callback != 0)
 	{
-		s_TOIE1Callback();
+		callback();
 	}
 }
 
 
 ISR(TIMER1_COMPA_vect)
 {
-	if (s_OCI1ACallback != 0)
+	rc::Timer1::Callback callback = s_OCI1ACallback;
+	if (callback != 0)
 	{
-		s_OCI1ACallback();
+		callback();
 	}
 }
 
 
 ISR(TIMER1_COMPB_vect)
 {
-	if (s_OCI1BCallback != 0)
+	rc::Timer1::Callback callback = s_OCI1BCallback;
+	if (callback != 0)
 	{
-		s_OCI1BCallback();
+		callback();
 	}
 }
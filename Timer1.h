@@ -22,7 +22,9 @@ namespace rc
 
 /*! 
  *  \brief     Class to encapsulate Timer1 functions.
- *  \details   This class provides centralised Timer1 controls.
+ *  \details   This class provides centralised Timer1 controls. The counter runs freely and is shared,
+ *             PPMIn, PPMOut, ServoIn, ServoOut and SBUSIn all time with it at the same time.
+ *             The two compare units are handed out by claimCompare, PPMOut and ServoOut each take one.
  *  \author    Daniel van den Ouden
  *  \date      Feb-2012
  *  \warning   This class should <b>NOT</b> be used together with the standard Arduino Servo library,
@@ -34,21 +36,60 @@ class Timer1
 public:
 	typedef void (*Callback)(void); //!< Callback function for interrupt routines
 	
+	enum Compare //! Output Compare unit
+	{
+		Compare_A,    //!< Output Compare A, OCR1A, drives OC1A (pin 9)
+		Compare_B,    //!< Output Compare B, OCR1B, drives OC1B (pin 10)
+		Compare_None  //!< No Output Compare unit, or any free one when claiming
+	};
+	
 	/*! \brief Sets all default values, call this first.
 	    \param p_debug Whether or not to run at debug speed (/256).
 	    \note  This function should be called prior to using any other Timer1 function.*/
 	static void init(bool p_debug = false);
 	
-	/*! \brief Starts timer1.*/
+	/*! \brief Starts timer1.
+	    \details The counter keeps running freely from 0 to 0xFFFF, calling this while it's
+	             running doesn't disturb it. The overflows are counted for getTime().*/
 	static void start();
 	
 	/*! \brief Checks if timer1 is running.
 	    \return Whether or not timer1 is running.*/
 	static bool isRunning();
 	
-	/*! \brief Stops timer1.*/
+	/*! \brief Stops timer1.
+	    \warning Every user of Timer1 stops with it, the classes of this library leave it running.*/
 	static void stop();
 	
+	/*! \brief Gets the time since the start, extended to 32 bits by counting overflows.
+	    \return Time in timer ticks of 0.5 us, wraps after about 35 minutes.
+	    \note Only counts while in normal mode, so not while PWMOut is in use.*/
+	static uint32_t getTime();
+	
+	/*! \brief Checks if any part of Timer1 has been claimed.
+	    \return Whether a compare unit, the input capture unit, the overflow callback or an overflow hook is in use.
+	    \note Users which only read the counter, like ServoIn, SBUSIn and PPMIn on other pins than 8, claim nothing.*/
+	static bool isClaimed();
+	
+	/*! \brief Claims an Output Compare unit and enables its Compare Match Interrupt.
+	    \param p_callback Function to call at interrupt.
+	    \param p_delay Timer ticks from now until the first match.
+	    \param p_compare Unit to claim, Compare_None for any free one.
+	    \return The claimed unit, Compare_None if it's taken by someone else or Fast PWM mode is on.
+	    \details A unit is taken as long as its interrupt is enabled. The counter isn't touched,
+	             the callback moves the compare register on from match to match.*/
+	static Compare claimCompare(Callback p_callback, uint16_t p_delay, Compare p_compare = Compare_None);
+	
+	/*! \brief Releases an Output Compare unit, disables its interrupt and pin toggling.
+	    \param p_compare Unit to release, Compare_None is ignored.
+	    \details When the unit was toggling OC1A/OC1B its output is forced low first.*/
+	static void releaseCompare(Compare p_compare);
+	
+	/*! \brief Gets the compare register of an Output Compare unit.
+	    \param p_compare Unit to get the register of, may not be Compare_None.
+	    \return OCR1A or OCR1B.*/
+	static volatile uint16_t* getCompareRegister(Compare p_compare);
+	
 	/*! \brief Enables/Disables Compare Match Interrupt.
 	    \param p_enable Whether to enable or disable Compare Match Interrupt.
 	    \param p_OCIE1A Whether to use OCIE1A or OCIE1B.
@@ -60,11 +101,45 @@ public:
 	    \param p_callback Function to call at interrupt.*/
 	static void setOverflow(bool p_enable, Callback p_callback = 0);
 	
+	/*! \brief Adds a function to call at every overflow, next to the one of setOverflow.
+	    \param p_callback Function to call at interrupt.
+	    \return Whether there was room for the function, see RC_TIMER1_OVERFLOW_HOOKS.*/
+	static bool addOverflowHook(Callback p_callback);
+	
+	/*! \brief Removes a function added by addOverflowHook.
+	    \param p_callback Function to remove.*/
+	static void removeOverflowHook(Callback p_callback);
+	
 	/*! \brief Enables/Disables Toggle pin on Compare Match A.
 	    \param p_enable Whether to enable or disable toggle pin.
 	    \param p_OC1A Whether to toggle OC1A or OC1B.*/
 	static void setToggle(bool p_enable, bool p_OC1A);
 	
+	/*! \brief Enables/Disables Fast PWM mode with ICR1 as TOP.
+	    \param p_enable Whether to use Fast PWM mode or count freely from 0 to 0xFFFF.
+	    \param p_top Value at which the counter starts over, a period takes p_top + 1 ticks.
+	    \warning Timer1 no longer runs freely in this mode and the input capture unit is off,
+	              ServoOut, PPMOut, PPMIn and ServoIn won't work while it's enabled.*/
+	static void setFastPWM(bool p_enable, uint16_t p_top = 0xFFFF);
+	
+	/*! \brief Checks if Fast PWM mode is enabled.
+	    \return Whether Timer1 is in Fast PWM mode with ICR1 as TOP.*/
+	static bool isFastPWM();
+	
+	/*! \brief Enables/Disables PWM output on OC1A (pin 9) or OC1B (pin 10).
+	    \param p_enable Whether to enable or disable PWM output.
+	    \param p_OC1A Whether to use OC1A or OC1B.
+	    \note The pin is set at the start of each period and cleared on Compare Match, OCR1A or OCR1B
+	           sets the length of the pulse. Make the pin an output pin yourself.*/
+	static void setPWM(bool p_enable, bool p_OC1A);
+	
+	/*! \brief Enables/Disables Input Capture Interrupt on ICP1 (pin 8).
+	    \param p_enable Whether to enable or disable Input Capture Interrupt.
+	    \param p_rising Whether to capture rising or falling edges.
+	    \param p_callback Function to call at interrupt, the captured time can be read from ICR1.
+	    \note The noise canceler is enabled, this delays each capture by 4 CPU cycles.*/
+	static void setInputCapture(bool p_enable, bool p_rising, Callback p_callback = 0);
+	
 	
 private:
 	Timer1(); //!< Not instantiable
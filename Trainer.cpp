@@ -11,6 +11,7 @@
 ** Website: http://sourceforge.net/p/arduinorclib/
 ** -------------------------------------------------------------------------*/
 
+#define RC_MODULE RC_MODULE_PPM
 #include <rc_debug_lib.h>
 #include <Trainer.h>
 #include <util.h>
@@ -14,6 +14,7 @@
 #include <Arduino.h>
 
 #include <TriStateSwitch.h>
+#define RC_MODULE RC_MODULE_SWITCH
 #include <rc_debug_lib.h>
 
 
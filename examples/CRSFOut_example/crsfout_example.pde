@@ -0,0 +1,49 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** crsfout_example.pde
+** Demonstrate CRSF Output functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <CRSFOut.h>
+#include <outputchannel.h>
+#include <util.h>
+
+
+rc::CRSFOut g_CRSFOut;
+
+void setup()
+{
+	// Connect the TX pin (pin 1) to the CRSF pin of the transmitter module.
+	// The UART is used for CRSF, so Serial can't be used at the same time.
+	// Enable RC_USE_UART in rc_config.h to let CRSFOut handle the data register empty interrupt,
+	// if you want to do this yourself call g_CRSFOut.dataRegisterEmpty() from your interrupt handler.
+	
+	// fill channel values buffer with sane values, all centered
+	for (uint8_t i = 0; i < RC_MAX_CHANNELS; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), rc::normalizedToMicros(0));
+	}
+	
+	// send 250 packets per second (default 150), the module should be set to the same rate
+	g_CRSFOut.setRate(250);
+	
+	// set up the UART for 400000 baud, 8 data bits, no parity, 1 stop bit
+	g_CRSFOut.start();
+}
+
+
+void loop()
+{
+	// do magic, put your values in the output channels, in microseconds
+	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(128));
+	
+	// sends a packet when the next one is due, the UART sends it in the background
+	g_CRSFOut.update();
+}
@@ -16,12 +16,19 @@
 
 rc::Expo g_expo;
 
+// optionally Expo can precalculate its response, apply() then only has to look it up.
+// this costs 256 bytes of RAM per Expo, so only use it when you have RAM to spare
+// uint8_t g_expoTable[rc::Expo::TableSize];
+
 void setup()
 {
 	// we use 30% expo, dumb down the sensitivity in the center a bit, if we
 	// want to make it more twitchy around the center we use a negative value
 	g_expo = 30;
 	
+	// the table will be filled now and whenever the expo is changed
+	// g_expo.setTable(g_expoTable);
+	
 	// Expo can also be used in combination with the input system
 	// g_expo.setIndex(rc::Input_AIL);
 	// or specify it as a constructor parameter
@@ -0,0 +1,42 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** fixeddualrates_example.pde
+** Demonstrate Dual Rates with the rates fixed at compile time
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <FixedDualRates.h>
+
+// when the rates never change they can be given as a template parameter,
+// apply() then multiplies by a constant instead of dividing by 100.
+// each rate is a different type, so we can't put them in an array
+rc::FixedDualRates<80>  g_normalRates; // normal mode, 80% response
+rc::FixedDualRates<100> g_stuntRates;  // stunt mode, we want faster response here
+
+// we can also use FixedDualRates in combination with the input system
+// by specifying an index to the input system as constructor parameter
+// rc::FixedDualRates<80> g_ailRates(rc::Input_AIL);
+
+void setup()
+{
+	// nothing to set up, the rate is part of the type
+}
+
+void loop()
+{
+	// we use A0 as input pin, we map raw input values (0 - 1024) to normalized
+	// values (-256 - 256)
+	int16_t normalized = map(analogRead(A0), 0, 1024, -256, 256);
+	
+	// and apply the rates, we use digital pin 3 as a flight mode switch
+	normalized = digitalRead(3) ? g_stuntRates.apply(normalized) : g_normalRates.apply(normalized);
+	
+	// we can then use the transformed value for further modification
+	// or we can transmit it using the PPMOut class
+}
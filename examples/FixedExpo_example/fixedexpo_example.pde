@@ -0,0 +1,42 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** fixedexpo_example.pde
+** Demonstrate Expo with the expo fixed at compile time
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <FixedExpo.h>
+
+// when the expo never changes it can be given as a template parameter,
+// the compiler then calculates the expo curve and apply() needs no divisions.
+// each expo value is a different type, so we can't put them in an array
+rc::FixedExpo<-30> g_normalExpo;
+rc::FixedExpo<-10> g_stuntExpo;
+
+// we can also use FixedExpo in combination with the input system
+// by specifying an index to the input system as constructor parameter
+// rc::FixedExpo<-30> g_ailExpo(rc::Input_AIL);
+
+void setup()
+{
+	// nothing to set up, the expo is part of the type
+}
+
+void loop()
+{
+	// we use A0 as input pin, we map raw input values (0 - 1024) to normalized
+	// values (-256 - 256)
+	int16_t normalized = map(analogRead(A0), 0, 1024, -256, 256);
+	
+	// and apply the expo, we use digital pin 3 as a flight mode switch
+	normalized = digitalRead(3) ? g_stuntExpo.apply(normalized) : g_normalExpo.apply(normalized);
+	
+	// we can then use the transformed value for further modification
+	// or we can transmit it using the PPMOut class
+}
@@ -23,10 +23,13 @@ void setup()
 	// (PPMIn/PPMOut/ServoIn/ServoOut)
 	rc::Timer1::init();
 	
-	// We use pin 8 as PPM input pin
+	// We use pin 8 as PPM input pin, this is the input capture pin of Timer1 (ICP1)
+	// so the edges of the signal are timed by hardware, which gives the most accurate results.
+	// Pin 8 is used by the global buzzer as well, either disable RC_USE_BUZZER in rc_config.h
+	// or move the buzzer to another pin.
 	g_PPMIn.setPin(8);
 	
-	// PPMIn will handle the pin change interrupts, if you want to do this yourself
+	// On other pins PPMIn will handle the pin change interrupts, if you want to do this yourself
 	// remove the line #define RC_USE_PCINT from rc_config.h and call g_PPMIn.pinChanged(p_high)
 	// from your interrupt handler.
 	
@@ -53,4 +56,11 @@ void loop()
 	{
 		// signal has been lost (no new valid frames for 'timeout' milliseconds)
 	}
+	
+	// The interrupt routine keeps statistics about the quality of the signal,
+	// like the number of frames, the times the signal was lost and the longest time
+	// between two frames. getStats gets a consistent copy, you may report these every
+	// now and then. resetStats starts counting from 0 again.
+	rc::InputStats stats;
+	g_PPMIn.getStats(stats);
 }
@@ -0,0 +1,48 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** pwmout_example.pde
+** Demonstrate hardware Servo Signal Output functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <outputchannel.h>
+#include <PWMOut.h>
+#include <Timer1.h>
+
+// PWMOut sends output channel 1 on pin 9 and output channel 2 on pin 10
+rc::PWMOut g_PWMOut(rc::OutputChannel_1, rc::OutputChannel_2);
+
+void setup()
+{
+	// Initialize timer1, PWMOut takes it over completely,
+	// so it can't be used together with PPMIn/PPMOut/ServoIn/ServoOut
+	rc::Timer1::init();
+	
+	// fill input buffer, convert raw values to normalized ones
+	rc::setOutputChannel(rc::OutputChannel_1, map(analogRead(A0), 0, 1024, 1000, 2000));
+	rc::setOutputChannel(rc::OutputChannel_2, map(analogRead(A1), 0, 1024, 1000, 2000));
+	
+	// Analog servos expect a pulse every 20 ms, digital servos and ESCs can take a much higher rate.
+	// Uncomment this line to refresh the servos at 333 Hz.
+	//g_PWMOut.setFrameLength(3000);
+	
+	// pins 9 and 10 are set up by start()
+	g_PWMOut.start();
+}
+
+void loop()
+{
+	// update the input buffer
+	rc::setOutputChannel(rc::OutputChannel_1, map(analogRead(A0), 0, 1024, 1000, 2000));
+	rc::setOutputChannel(rc::OutputChannel_2, map(analogRead(A1), 0, 1024, 1000, 2000));
+	
+	// tell PWMOut there are new values available in the input buffer,
+	// the hardware generates the pulses, there's no interrupt that can be delayed
+	g_PWMOut.update();
+}
@@ -0,0 +1,58 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** sbusin_example.pde
+** Demonstrate SBUS Input functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <SBUSIn.h>
+#include <Timer1.h>
+
+
+rc::SBUSIn g_SBUSIn;
+
+void setup()
+{
+	// Initialize timer1, this is required for all features that use Timer1
+	// (PPMIn/PPMOut/ServoIn/ServoOut/SBUSIn)
+	rc::Timer1::init();
+	
+	// SBUS is an inverted serial signal, connect the receiver to the RX pin (pin 0)
+	// through an inverter, a single transistor will do.
+	// The UART is used for SBUS, so Serial can't be used at the same time.
+	// Enable RC_USE_UART in rc_config.h to let SBUSIn handle the receive interrupt,
+	// if you want to do this yourself call g_SBUSIn.byteReceived(data, valid)
+	// from your interrupt handler, valid is false if the byte had a framing or parity error.
+	
+	// set a timeout (default 500 milliseconds)
+	g_SBUSIn.setTimeout(1000);
+	
+	// start listening, this sets up the UART for 100000 baud, 8 data bits, even parity, 2 stop bits
+	g_SBUSIn.start();
+}
+
+
+void loop()
+{
+	// update incoming values
+	g_SBUSIn.update();
+	
+	if (g_SBUSIn.isStable())
+	{
+		// do magic, incoming values available in rc::getInputChannel() in microseconds.
+		// or use rc::getRawInputChannels() to get a pointer to the raw buffer
+		// see <inputchannel.h>
+		// channels 17 and 18 are the digital channels, 1000 or 2000 microseconds
+	}
+	else if (g_SBUSIn.isLost())
+	{
+		// signal has been lost (no new valid frames for 'timeout' milliseconds)
+		// or the receiver is in failsafe
+	}
+}
@@ -0,0 +1,51 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** sbusout_example.pde
+** Demonstrate SBUS Output functionality
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <outputchannel.h>
+#include <SBUSOut.h>
+#include <util.h>
+
+
+rc::SBUSOut g_SBUSOut;
+
+void setup()
+{
+	// SBUS is an inverted serial signal, connect the TX pin (pin 1) to the receiving end
+	// through an inverter, a single transistor will do.
+	// The UART is used for SBUS, so Serial can't be used at the same time.
+	// Enable RC_USE_UART in rc_config.h to let SBUSOut handle the data register empty interrupt,
+	// if you want to do this yourself call g_SBUSOut.dataRegisterEmpty() from your interrupt handler.
+	
+	// fill channel values buffer with sane values, all centered
+	for (uint8_t i = 0; i < RC_MAX_CHANNELS; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), rc::normalizedToMicros(0));
+	}
+	
+	// send a frame every 7 milliseconds (high speed), default is 14 milliseconds
+	g_SBUSOut.setFrameLength(7000);
+	
+	// set up the UART for 100000 baud, 8 data bits, even parity, 2 stop bits
+	g_SBUSOut.start();
+}
+
+
+void loop()
+{
+	// do magic, put your values in the output channels, in microseconds
+	// channels 17 and 18 are the digital channels, on above 1500 microseconds
+	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(128));
+	
+	// sends a frame when the next one is due, the UART sends it in the background
+	g_SBUSOut.update();
+}
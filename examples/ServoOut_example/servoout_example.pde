@@ -44,6 +44,15 @@ void setup()
 		// we'll need to cast our iterator to an OutputChannel, but ugly but safe
 		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), map(analogRead(g_pinsIn[i]), 0, 1024, 1000, 2000));
 	}
+	
+	// By default the servos get their pulses one after the other, with 4 servos of up to 2 ms
+	// that's a frame of 8 ms. Digital servos and ESCs can take a much higher refresh rate.
+	// Pins 2 to 5 are all on port D, so they can get their pulses at the same time
+	// in a bank, which takes only as long as the longest pulse.
+	// Uncomment these lines to refresh the servos at 333 Hz.
+	//g_ServoOut.setBankSize(4);
+	//g_ServoOut.setPauseLength(3000);
+	
 	g_ServoOut.start();
 }
 
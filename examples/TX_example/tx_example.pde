@@ -23,6 +23,7 @@
 #include <InputToInputMix.h>
 #include <PPMOut.h>
 #include <Swashplate.h>
+#include <SwashToThrottleMix.h>
 #include <ThrottleHold.h>
 #include <Timer1.h>
 #include <util.h>
@@ -140,11 +141,11 @@ void setup()
 	
 	// fill channel values buffer with sane values, all centered
 	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(0));
-	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(0));
-	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(-256)); // Throttle channel, MUST BE AT 0 THROTTLE!
-	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(0));
-	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(0));
-	rc::setOutputChannel(rc::OutputChannel_1, rc::normalizedToMicros(0));
+	rc::setOutputChannel(rc::OutputChannel_2, rc::normalizedToMicros(0));
+	rc::setOutputChannel(rc::OutputChannel_3, rc::normalizedToMicros(-256)); // Throttle channel, MUST BE AT 0 THROTTLE!
+	rc::setOutputChannel(rc::OutputChannel_4, rc::normalizedToMicros(0));
+	rc::setOutputChannel(rc::OutputChannel_5, rc::normalizedToMicros(0));
+	rc::setOutputChannel(rc::OutputChannel_6, rc::normalizedToMicros(0));
 	
 	// set up PPM
 	g_PPMOut.setPulseLength(448);   // default pulse length used by Esky hardware
@@ -169,7 +170,7 @@ void loop()
 	
 	// apply swash to throttle mix
 	// since we want this mix to ignore any curves or expo, we apply it now
-	g_SwToThr();
+	g_SwToThr.apply();
 	
 	// apply expo and dual rates to input, these read from and write to input system
 	g_ailExpo[flightmode].apply();
@@ -0,0 +1,62 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** adc_example.pde
+** Demonstrate the free running ADC sampler
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+// The sampler is only compiled in when RC_USE_ADC is defined in rc_config.h
+
+#include <AIPin.h>
+#include <rc_adc.h>
+
+// Creating an AIPin adds its pin to the sampler, so these four gimbal
+// axes will be converted in turn by the ADC interrupt.
+rc::AIPin g_pins[4] =
+{
+	rc::AIPin(A0, rc::Input_AIL),
+	rc::AIPin(A1, rc::Input_ELE),
+	rc::AIPin(A2, rc::Input_THR),
+	rc::AIPin(A3, rc::Input_RUD)
+};
+
+void setup()
+{
+	// the Arduino core sets up the ADC after our AIPins were created,
+	// so we start the sampler here. From now on analogRead can't be used.
+	rc::adc::start();
+	
+	// it takes a few milliseconds before every pin has been sampled
+	while (rc::adc::isReady() == false)
+	{
+		// wait
+	}
+}
+
+void loop()
+{
+	// reading the pins no longer waits for conversions, read returns the latest
+	// value the sampler has right away. With analogRead the four pins would
+	// keep the loop waiting for about 450 microseconds.
+	for (uint8_t i = 0; i < 4; ++i)
+	{
+		g_pins[i].read();
+	}
+	
+	// you can also get the oversampled value of a pin, with RC_ADC_OVERSAMPLING
+	// set to 2 this is the average of 16 conversions in the range [0 - 4092]
+	uint16_t raw = rc::adc::read(A0);
+	
+	// the sampler can be stopped when you need analogRead, give the conversion
+	// in progress time to complete first
+	rc::adc::stop();
+	delayMicroseconds(110);
+	raw = analogRead(A4);
+	rc::adc::start();
+}
@@ -117,6 +117,16 @@ void setup()
 	// When building a release build, turn all debugging features off to reduce
 	// the memory footprint and increase performance
 	
+	// The library is split up in modules (PPM, Servo, Mixer, Switch and IO), each with its
+	// own debug level in rc_debug_lib.h. This way you can trace PPMIn without getting the
+	// traces of every other class; modules below the level don't take any space or time.
+	// On top of that, the messages of each module can be turned on and off while running.
+	// Your own code is in RC_MODULE_USER, here we only let through the messages of the
+	// PPM module.
+	rc::setDebugMask(1 << RC_MODULE_PPM);
+	RC_INFO("This message won't be shown");
+	rc::setDebugMask(0xFF);
+	// Asserts are never masked.
 }
 
 void loop()
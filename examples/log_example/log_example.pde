@@ -0,0 +1,75 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** log_example.pde
+** Demonstrate the deferred binary log
+**
+** Note:
+** Decode the output on your PC with tools/rc_logdecode.py, it needs the elf
+** file of this sketch to look up the file names and format strings. Enable
+** verbose compilation output in the Arduino IDE to see where it's stored.
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+
+// Store the messages of this file as binary records instead of printing them.
+// You can also enable this for all files in rc_config.h
+#define RC_BINARY_LOG
+
+// include this file for the debugging functions, it includes rc_log.h
+#include <rc_debug.h>
+
+// the log is sent over serial (uart)
+#include <rc_uart.h>
+
+
+volatile uint16_t g_edges = 0;
+
+
+void edge()
+{
+	++g_edges;
+	
+	// storing a record only copies a few bytes, so it's fine to log from interrupt handlers
+	RC_TRACE("edge %u at %lu us", g_edges, micros());
+}
+
+
+void setup()
+{
+	// setup uart, the log is sent in binary so the serial monitor won't be of much use
+	rc::uart::init(115200);
+	
+	// The debugging macros work the same as with printed messages, see debug_example
+	// Instead of formatting the message they store a record with the file, line,
+	// format string and the raw arguments in the log buffer.
+	RC_INFO("Binary log example, the buffer holds %d bytes", RC_LOG_SIZE);
+	
+	// Strings in program space are logged by address, so use %S for those.
+	// Strings in RAM are looked up in the elf file as well, but only their initial contents are known.
+	RC_DEBUG("progmem %S", PSTR("strings are free"));
+	
+	attachInterrupt(0, edge, CHANGE);
+}
+
+
+void loop()
+{
+	// Move the log to the uart, as much as fits in its transmit buffer.
+	// This doesn't wait, so it can be called as often as you like.
+	rc::log::send();
+	
+	// If records are logged faster than they're sent the buffer fills up and new
+	// records are dropped, increase RC_LOG_SIZE in rc_config.h if that happens.
+	static uint16_t dropped = 0;
+	if (rc::log::getDropped() != dropped)
+	{
+		dropped = rc::log::getDropped();
+		RC_WARN("%u records dropped", dropped);
+	}
+}
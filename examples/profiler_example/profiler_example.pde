@@ -0,0 +1,97 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** profiler_example.pde
+** Demonstrate the loop profiler
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+// Enable RC_PROFILE for this file, you can also enable it for all files in rc_config.h
+// When it's not defined RC_PROFILE does nothing at all, so you can leave it in your code.
+#define RC_USE_PROFILER
+
+#include <AIPin.h>
+#include <Expo.h>
+#include <rc_profiler.h>
+#include <rc_uart.h>
+#include <Timer1.h>
+
+
+// Each stage has its own number, up to RC_PROFILER_STAGES in rc_config.h
+enum Stage
+{
+	Stage_Read,
+	Stage_Expo,
+	Stage_Loop
+};
+
+rc::AIPin g_pins[4] =
+{
+	rc::AIPin(A0, rc::Input_AIL),
+	rc::AIPin(A1, rc::Input_ELE),
+	rc::AIPin(A2, rc::Input_THR),
+	rc::AIPin(A3, rc::Input_RUD)
+};
+
+rc::Expo g_expo[2] =
+{
+	rc::Expo(30, rc::Input_AIL),
+	rc::Expo(30, rc::Input_ELE)
+};
+
+uint32_t g_lastDump = 0;
+
+
+void setup()
+{
+	// the profiler times with Timer1, so it needs to be running
+	rc::Timer1::init();
+	rc::Timer1::start();
+	
+	// the statistics are printed to stdout, so we send stdout over serial
+	rc::uart::init(115200);
+	rc::uart::setStdOut();
+	
+	// names make the statistics easier to read, keep them short (8 characters)
+	rc::profiler::setName(Stage_Read, PSTR("read"));
+	rc::profiler::setName(Stage_Expo, PSTR("expo"));
+	rc::profiler::setName(Stage_Loop, PSTR("loop"));
+}
+
+
+void loop()
+{
+	{
+		// time the complete block, RC_PROFILE times the rest of the block it's in
+		RC_PROFILE(Stage_Loop);
+		
+		{
+			RC_PROFILE(Stage_Read);
+			for (uint8_t i = 0; i < 4; ++i)
+			{
+				g_pins[i].read();
+			}
+		}
+		
+		{
+			RC_PROFILE(Stage_Expo);
+			g_expo[0].apply();
+			g_expo[1].apply();
+		}
+	}
+	
+	// Every second, print the statistics and start over. For every stage you'll see
+	// how often it ran and the shortest, average and longest time it took in microseconds,
+	// followed by a histogram of the times. Here reading the pins takes most of the time.
+	if (millis() - g_lastDump >= 1000)
+	{
+		g_lastDump = millis();
+		rc::profiler::dump();
+		rc::profiler::reset();
+	}
+}
@@ -0,0 +1,56 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** tick_example.pde
+** Demonstrate the frame time
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <AnalogSwitch.h>
+#include <BiStateSwitch.h>
+#include <Channel.h>
+#include <FlightTimer.h>
+#include <rc_tick.h>
+
+// a switch on pin 3, which flies the timer and slowly moves a flap servo
+rc::BiStateSwitch g_switch(3, rc::Switch_A);
+rc::FlightTimer   g_timer(rc::Switch_A, rc::SwitchState_Up);
+rc::AnalogSwitch  g_flaps(rc::Switch_A, rc::Input_FLP);
+
+// a throttle channel with servo speed
+rc::Channel g_throttle(rc::Output_THR1, rc::OutputChannel_1);
+
+uint32_t g_blink = 0; // time since the LED changed in microseconds
+
+void setup()
+{
+	pinMode(13, OUTPUT);
+	
+	g_flaps.setDuration(2000); // two seconds from up to down
+	g_throttle.setSpeed(10);   // one second from idle to full throttle
+}
+
+void loop()
+{
+	// sample the time once, everything below works with the same time
+	rc::tick::update();
+	
+	g_switch.read();
+	g_timer.update();
+	g_flaps.update();
+	g_throttle.apply();
+	
+	// your own code can use the time between this loop and the previous one,
+	// here we blink the LED twice a second
+	g_blink += rc::tick::getDelta();
+	if (g_blink >= 250000)
+	{
+		g_blink -= 250000;
+		digitalWrite(13, !digitalRead(13));
+	}
+}
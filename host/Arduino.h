@@ -0,0 +1,70 @@
+#ifndef INC_RC_HOST_ARDUINO_H
+#define INC_RC_HOST_ARDUINO_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** Arduino.h
+** Host replacement for the Arduino core, backed by the simulator in rc_host.h
+** Pin mapping follows the Arduino Uno (Atmega328p)
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define NOT_A_PORT 0
+#define PB 2
+#define PC 3
+#define PD 4
+
+static const uint8_t A0 = 14;
+static const uint8_t A1 = 15;
+static const uint8_t A2 = 16;
+static const uint8_t A3 = 17;
+static const uint8_t A4 = 18;
+static const uint8_t A5 = 19;
+
+typedef uint8_t boolean;
+typedef uint8_t byte;
+
+#define digitalPinToPort(P)     (((P) <= 7) ? PD : (((P) <= 13) ? PB : (((P) <= 19) ? PC : NOT_A_PORT)))
+#define digitalPinToBitMask(P)  (_BV(((P) <= 7) ? (P) : (((P) <= 13) ? (P) - 8 : (P) - 14)))
+#define digitalPinToPCMSKbit(P) (((P) <= 7) ? (P) : (((P) <= 13) ? (P) - 8 : (P) - 14))
+
+#define portInputRegister(P)  (&_SFR_IO8(((P) - PB) * 3 + 0x03))
+#define portModeRegister(P)   (&_SFR_IO8(((P) - PB) * 3 + 0x04))
+#define portOutputRegister(P) (&_SFR_IO8(((P) - PB) * 3 + 0x05))
+
+void pinMode(uint8_t p_pin, uint8_t p_mode);
+void digitalWrite(uint8_t p_pin, uint8_t p_value);
+int  digitalRead(uint8_t p_pin);
+int  analogRead(uint8_t p_pin);
+
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long p_ms);
+void delayMicroseconds(unsigned int p_us);
+
+long map(long p_x, long p_inMin, long p_inMax, long p_outMin, long p_outMax);
+
+#endif // INC_RC_HOST_ARDUINO_H
@@ -0,0 +1,48 @@
+#ifndef INC_RC_HOST_AVR_INTERRUPT_H
+#define INC_RC_HOST_AVR_INTERRUPT_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** avr/interrupt.h
+** Host replacement for avr-libc's interrupt header
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <avr/io.h>
+
+
+// Interrupt vectors are plain functions on the host, the simulator calls them
+// when the matching interrupt flag and mask bits are set.
+#define ISR(vector, ...) extern "C" void vector(void); extern "C" void vector(void)
+#define SIGNAL(vector)   ISR(vector)
+
+#define cli() do { SREG &= ~_BV(SREG_I); } while (0)
+#define sei() do { SREG |=  _BV(SREG_I); } while (0)
+
+extern "C"
+{
+	void INT0_vect(void);
+	void INT1_vect(void);
+	void PCINT0_vect(void);
+	void PCINT1_vect(void);
+	void PCINT2_vect(void);
+	void TIMER2_COMPA_vect(void);
+	void TIMER2_COMPB_vect(void);
+	void TIMER2_OVF_vect(void);
+	void TIMER1_CAPT_vect(void);
+	void TIMER1_COMPA_vect(void);
+	void TIMER1_COMPB_vect(void);
+	void TIMER1_OVF_vect(void);
+	void USART_RX_vect(void);
+	void USART_UDRE_vect(void);
+	void USART_TX_vect(void);
+	void ADC_vect(void);
+}
+
+#endif // INC_RC_HOST_AVR_INTERRUPT_H
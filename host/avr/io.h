@@ -0,0 +1,233 @@
+#ifndef INC_RC_HOST_AVR_IO_H
+#define INC_RC_HOST_AVR_IO_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** avr/io.h
+** Host replacement for avr-libc's io header, simulated Atmega328p registers
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+
+// All registers live in a simulated data space, using the same addresses as the
+// Atmega328p so code relying on the PINx/DDRx/PORTx layout keeps working.
+extern "C" volatile uint8_t rc_host_sfr[0x100];
+
+// Writing a one to a PINx bit toggles the matching PORTx bit, so the PINx slots in
+// the data space act as write strobes and always read zero. Pin levels are kept here.
+extern "C" volatile uint8_t rc_host_pin[3];
+
+#define _SFR_MEM8(addr)  (*(volatile uint8_t*)(rc_host_sfr + (addr)))
+#define _SFR_MEM16(addr) (*(volatile uint16_t*)(rc_host_sfr + (addr)))
+#define _SFR_IO8(addr)   _SFR_MEM8((addr) + 0x20)
+
+#define _BV(bit) (1 << (bit))
+
+// Interrupt flags are cleared by writing a one to them, like on the chip.
+// The simulator itself sets and clears them with |= and &=.
+struct rc_host_flags
+{
+	volatile uint8_t& reg;
+	
+	operator uint8_t() const { return reg; }
+	void operator=(uint8_t p_value) const  { reg &= ~p_value; }
+	void operator|=(uint8_t p_value) const { reg |= p_value; }
+	void operator&=(uint8_t p_value) const { reg &= p_value; }
+};
+
+#define bit_is_set(sfr, bit)   ((sfr) & _BV(bit))
+#define bit_is_clear(sfr, bit) (!((sfr) & _BV(bit)))
+#define loop_until_bit_is_set(sfr, bit)   do { } while (bit_is_clear(sfr, bit))
+#define loop_until_bit_is_clear(sfr, bit) do { } while (bit_is_set(sfr, bit))
+
+#define F_CPU 16000000UL
+
+// Ports
+#define PINB  (rc_host_pin[0])
+#define DDRB  _SFR_IO8(0x04)
+#define PORTB _SFR_IO8(0x05)
+#define PINC  (rc_host_pin[1])
+#define DDRC  _SFR_IO8(0x07)
+#define PORTC _SFR_IO8(0x08)
+#define PIND  (rc_host_pin[2])
+#define DDRD  _SFR_IO8(0x0A)
+#define PORTD _SFR_IO8(0x0B)
+
+// Interrupt flags and masks
+#define TIFR0  (rc_host_flags{_SFR_IO8(0x15)})
+#define TIFR1  (rc_host_flags{_SFR_IO8(0x16)})
+#define TIFR2  (rc_host_flags{_SFR_IO8(0x17)})
+#define PCIFR  (rc_host_flags{_SFR_IO8(0x1B)})
+#define EIFR   (rc_host_flags{_SFR_IO8(0x1C)})
+#define EIMSK  _SFR_IO8(0x1D)
+#define SREG   _SFR_IO8(0x3F)
+#define PCICR  _SFR_MEM8(0x68)
+#define EICRA  _SFR_MEM8(0x69)
+#define PCMSK0 _SFR_MEM8(0x6B)
+#define PCMSK1 _SFR_MEM8(0x6C)
+#define PCMSK2 _SFR_MEM8(0x6D)
+#define TIMSK0 _SFR_MEM8(0x6E)
+#define TIMSK1 _SFR_MEM8(0x6F)
+#define TIMSK2 _SFR_MEM8(0x70)
+
+// ADC
+#define ADCL   _SFR_MEM8(0x78)
+#define ADCH   _SFR_MEM8(0x79)
+#define ADC    _SFR_MEM16(0x78)
+#define ADCSRA _SFR_MEM8(0x7A)
+#define ADCSRB _SFR_MEM8(0x7B)
+#define ADMUX  _SFR_MEM8(0x7C)
+#define DIDR0  _SFR_MEM8(0x7E)
+
+// Timer1
+#define TCCR1A _SFR_MEM8(0x80)
+#define TCCR1B _SFR_MEM8(0x81)
+#define TCCR1C rc_host_tccr1c
+#define TCNT1  _SFR_MEM16(0x84)
+#define ICR1   _SFR_MEM16(0x86)
+#define OCR1A  _SFR_MEM16(0x88)
+#define OCR1B  _SFR_MEM16(0x8A)
+
+// Timer2
+#define TCCR2A _SFR_MEM8(0xB0)
+#define TCCR2B _SFR_MEM8(0xB1)
+#define TCNT2  _SFR_MEM8(0xB2)
+#define OCR2A  _SFR_MEM8(0xB3)
+#define OCR2B  _SFR_MEM8(0xB4)
+
+// USART0
+#define UCSR0A _SFR_MEM8(0xC0)
+#define UCSR0B _SFR_MEM8(0xC1)
+#define UCSR0C _SFR_MEM8(0xC2)
+#define UBRR0L _SFR_MEM8(0xC4)
+#define UBRR0H _SFR_MEM8(0xC5)
+
+// UDR0 is two registers, writing fills the transmit buffer and reading empties the receive
+// buffer. It's an object instead of a slot in the data space so the simulator sees both.
+struct rc_host_udr
+{
+	void operator=(uint8_t p_value) volatile;
+	operator uint8_t() volatile;
+};
+extern volatile rc_host_udr rc_host_udr0;
+#define UDR0 rc_host_udr0
+
+// TCCR1C only holds the Force Output Compare strobes, which act on the compare outputs
+// as soon as they're written and always read as zero.
+struct rc_host_foc
+{
+	void operator=(uint8_t p_value) volatile;
+	operator uint8_t() volatile { return 0; }
+};
+extern volatile rc_host_foc rc_host_tccr1c;
+
+// SREG
+#define SREG_I 7
+
+// TIFR1 / TIMSK1
+#define TOV1   0
+#define OCF1A  1
+#define OCF1B  2
+#define ICF1   5
+#define TOIE1  0
+#define OCIE1A 1
+#define OCIE1B 2
+#define ICIE1  5
+
+// TCCR1A / TCCR1B
+#define WGM10  0
+#define WGM11  1
+#define COM1B0 4
+#define COM1B1 5
+#define COM1A0 6
+#define COM1A1 7
+#define CS10   0
+#define CS11   1
+#define CS12   2
+#define WGM12  3
+#define WGM13  4
+#define ICES1  6
+#define ICNC1  7
+
+// TCCR1C
+#define FOC1B  6
+#define FOC1A  7
+
+// TIFR2 / TIMSK2 / TCCR2A / TCCR2B
+#define TOV2   0
+#define OCF2A  1
+#define OCF2B  2
+#define TOIE2  0
+#define OCIE2A 1
+#define OCIE2B 2
+#define WGM20  0
+#define WGM21  1
+#define COM2B0 4
+#define COM2B1 5
+#define COM2A0 6
+#define COM2A1 7
+#define CS20   0
+#define CS21   1
+#define CS22   2
+#define WGM22  3
+
+// EICRA / EIMSK
+#define ISC00 0
+#define ISC01 1
+#define ISC10 2
+#define ISC11 3
+#define INT0  0
+#define INT1  1
+
+// PCICR
+#define PCIE0 0
+#define PCIE1 1
+#define PCIE2 2
+
+// ADCSRA / ADMUX
+#define ADPS0 0
+#define ADPS1 1
+#define ADPS2 2
+#define ADIE  3
+#define ADIF  4
+#define ADATE 5
+#define ADSC  6
+#define ADEN  7
+#define MUX0  0
+#define ADLAR 5
+#define REFS0 6
+#define REFS1 7
+
+// UCSR0A / UCSR0B / UCSR0C
+#define MPCM0  0
+#define U2X0   1
+#define UPE0   2
+#define DOR0   3
+#define FE0    4
+#define UDRE0  5
+#define TXC0   6
+#define RXC0   7
+#define TXB80  0
+#define RXB80  1
+#define UCSZ02 2
+#define TXEN0  3
+#define RXEN0  4
+#define UDRIE0 5
+#define TXCIE0 6
+#define RXCIE0 7
+#define UCPOL0 0
+#define UCSZ00 1
+#define UCSZ01 2
+#define USBS0  3
+#define UPM00  4
+#define UPM01  5
+
+#endif // INC_RC_HOST_AVR_IO_H
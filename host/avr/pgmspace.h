@@ -0,0 +1,51 @@
+#ifndef INC_RC_HOST_AVR_PGMSPACE_H
+#define INC_RC_HOST_AVR_PGMSPACE_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** avr/pgmspace.h
+** Host replacement for avr-libc's program space header
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <avr/io.h>
+
+
+// There is only one address space on the host
+#define PROGMEM
+#define PSTR(s) (s)
+
+// Types of older avr-libc versions, the library still uses them
+typedef char     prog_char;
+typedef uint8_t  prog_uint8_t;
+typedef int8_t   prog_int8_t;
+typedef uint16_t prog_uint16_t;
+typedef int16_t  prog_int16_t;
+typedef uint32_t prog_uint32_t;
+typedef int32_t  prog_int32_t;
+
+#define pgm_read_byte(addr)  (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_word(addr)  (*reinterpret_cast<const uint16_t*>(addr))
+#define pgm_read_dword(addr) (*reinterpret_cast<const uint32_t*>(addr))
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+#define strcmp_P strcmp
+
+// avr-libc uses %S for strings in program space, these translate it to %s.
+int vfprintf_P(FILE* p_stream, const char* p_fmt, va_list p_args);
+int fprintf_P(FILE* p_stream, const char* p_fmt, ...);
+int printf_P(const char* p_fmt, ...);
+
+#endif // INC_RC_HOST_AVR_PGMSPACE_H
@@ -0,0 +1,110 @@
+#ifndef INC_RC_BENCH_H
+#define INC_RC_BENCH_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** bench.h
+** Cycle counter and statistics for the host benchmarks
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <algorithm>
+#include <chrono>
+#include <inttypes.h>
+#include <stdio.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+
+namespace rc {
+namespace bench {
+
+	/*! \brief Reads the host cycle counter.
+	    \return Time stamp counter on x86, nanoseconds elsewhere.*/
+	inline uint64_t now()
+	{
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+	}
+	
+	/*! \brief Collects samples of a single code path.*/
+	class Stats
+	{
+	public:
+		enum
+		{
+			MaxSamples = 65536 //!< Samples beyond this are dropped.
+		};
+		
+		Stats(const char* p_name) : m_name(p_name), m_count(0) { }
+		
+		/*! \brief Adds a sample.
+		    \param p_cycles Duration of one run of the code path.*/
+		void add(uint64_t p_cycles)
+		{
+			if (m_count < MaxSamples)
+			{
+				m_samples[m_count] = p_cycles;
+				++m_count;
+			}
+		}
+		
+		/*! \brief Removes all samples.*/
+		void clear() { m_count = 0; }
+		
+		/*! \brief Gets the lowest sample, use this as measurement overhead.
+		    \return Lowest sample, 0 when there are none.*/
+		uint64_t getMin() const
+		{
+			return m_count == 0 ? 0 : *std::min_element(m_samples, m_samples + m_count);
+		}
+		
+		/*! \brief Prints min, median, 99th percentile, max and jitter.
+		    \details Jitter is p99 - min, the max mostly shows the host being preempted.
+		    \param p_overhead Cycles to subtract from every sample.*/
+		void print(uint64_t p_overhead = 0)
+		{
+			if (m_count == 0)
+			{
+				printf("%-40s no samples\n", m_name);
+				return;
+			}
+			std::sort(m_samples, m_samples + m_count);
+			uint64_t min = sub(m_samples[0], p_overhead);
+			uint64_t med = sub(m_samples[m_count / 2], p_overhead);
+			uint64_t p99 = sub(m_samples[(m_count * 99) / 100], p_overhead);
+			uint64_t max = sub(m_samples[m_count - 1], p_overhead);
+			printf("%-40s %7u %7" PRIu64 " %7" PRIu64 " %7" PRIu64 " %7" PRIu64 " %7" PRIu64 "\n",
+			       m_name, static_cast<unsigned>(m_count), min, med, p99, max, p99 - min);
+		}
+		
+		/*! \brief Prints the column names for print().*/
+		static void printHeader()
+		{
+			printf("%-40s %7s %7s %7s %7s %7s %7s\n", "path", "n", "min", "median", "p99", "max", "jitter");
+		}
+		
+	private:
+		static uint64_t sub(uint64_t p_a, uint64_t p_b) { return p_a > p_b ? p_a - p_b : 0; }
+		
+		const char* m_name;
+		uint32_t    m_count;
+		uint64_t    m_samples[MaxSamples];
+	};
+
+} // bench
+} // rc
+
+#endif // INC_RC_BENCH_H
@@ -0,0 +1,186 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** bench_isr.cpp
+** Time spent in the PPMOut and ServoOut compare match interrupt routines
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <outputchannel.h>
+#include <PPMOut.h>
+#include <rc_host.h>
+#include <ServoOut.h>
+#include <Timer1.h>
+
+#include "bench.h"
+
+
+// The interrupt routines are timed by replacing the Timer1 callbacks with wrappers.
+// Each call is assigned to a path by its position in the frame, the first frames
+// are skipped so caches and branch predictors are warmed up.
+
+enum
+{
+	Frames       = 2000,
+	WarmupFrames = 20,
+	Servos       = 6
+};
+
+static rc::bench::Stats s_overhead("measurement overhead");
+static rc::bench::Stats s_ppmChannel("PPMOut::isr channel");
+static rc::bench::Stats s_ppmFrame("PPMOut::isr end of frame");
+static rc::bench::Stats s_servoPulse("ServoOut::isr pulse");
+static rc::bench::Stats s_servoFrame("ServoOut::isr end of frame");
+
+static uint32_t s_calls = 0;     // interrupts since start
+static uint32_t s_callsFrame = 0; // interrupts per frame
+static uint32_t s_lastCall = 0;   // position of the end of frame call in a frame
+
+
+static void empty()
+{
+}
+
+
+static void measureOverhead()
+{
+	void (* volatile fn)() = empty;
+	for (uint32_t i = 0; i < 10000; ++i)
+	{
+		uint64_t start = rc::bench::now();
+		fn();
+		s_overhead.add(rc::bench::now() - start);
+	}
+}
+
+
+static void timedPPMOut()
+{
+	uint64_t start = rc::bench::now();
+	rc::PPMOut::handleInterrupt();
+	uint64_t end = rc::bench::now();
+	
+	if (s_calls >= s_callsFrame * WarmupFrames)
+	{
+		((s_calls % s_callsFrame) == s_lastCall ? s_ppmFrame : s_ppmChannel).add(end - start);
+	}
+	++s_calls;
+}
+
+
+static void timedServoOut()
+{
+	uint64_t start = rc::bench::now();
+	rc::ServoOut::handleInterrupt();
+	uint64_t end = rc::bench::now();
+	
+	if (s_calls >= s_callsFrame * WarmupFrames)
+	{
+		((s_calls % s_callsFrame) == s_lastCall ? s_servoFrame : s_servoPulse).add(end - start);
+	}
+	++s_calls;
+}
+
+
+static void setChannels(uint8_t p_channels, uint32_t p_frame)
+{
+	for (uint8_t i = 0; i < p_channels; ++i)
+	{
+		// move the sticks a bit so every frame is different
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), 1000 + ((p_frame * 7 + i * 100) % 1000));
+	}
+}
+
+
+static void benchPPMOut(uint8_t p_pin, uint8_t p_channels)
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	setChannels(p_channels, 0);
+	
+	rc::PPMOut out(p_channels);
+	out.start(p_pin);
+	
+	// time the unit PPMOut claimed, pins other than 9 and 10 don't get A
+	rc::Timer1::Compare compare = out.getCompare();
+	rc::Timer1::setCompareMatch(true, compare == rc::Timer1::Compare_A, timedPPMOut);
+	
+	// a frame has a pulse and a channel timing per channel, plus a final pulse and a pause.
+	// start() leaves the position at 1, the call that switches frames is the last one.
+	s_calls = 0;
+	s_callsFrame = (p_channels + 1) * 2;
+	s_lastCall = s_callsFrame - 2;
+	s_ppmChannel.clear();
+	s_ppmFrame.clear();
+	
+	for (uint32_t frame = 0; frame < Frames; ++frame)
+	{
+		setChannels(p_channels, frame);
+		out.update();
+		rc::host::advanceMicros(p_channels * 2000 + out.getPauseLength());
+	}
+	out.stop();
+	
+	printf("PPMOut, pin %u, %u channels\n", p_pin, p_channels);
+	s_ppmChannel.print(s_overhead.getMin());
+	s_ppmFrame.print(s_overhead.getMin());
+}
+
+
+static void benchServoOut()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	setChannels(Servos, 0);
+	
+	static uint8_t pins[RC_MAX_CHANNELS] = { 2, 3, 4, 5, 6, 7 };
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		pinMode(pins[i], OUTPUT);
+	}
+	
+	rc::ServoOut out(pins);
+	out.start();
+	rc::Timer1::setCompareMatch(true, out.getCompare() == rc::Timer1::Compare_A, timedServoOut);
+	
+	// one call per servo and one for the pause
+	s_calls = 0;
+	s_callsFrame = Servos + 1;
+	s_lastCall = Servos;
+	s_servoPulse.clear();
+	s_servoFrame.clear();
+	
+	for (uint32_t frame = 0; frame < Frames; ++frame)
+	{
+		setChannels(Servos, frame);
+		out.update();
+		rc::host::advanceMicros(out.getPauseLength() + Servos * 2000);
+	}
+	out.stop();
+	
+	printf("ServoOut, %u servos\n", Servos);
+	s_servoPulse.print(s_overhead.getMin());
+	s_servoFrame.print(s_overhead.getMin());
+}
+
+
+int main()
+{
+	measureOverhead();
+	
+	printf("host cycles per interrupt, measurement overhead subtracted\n");
+	rc::bench::Stats::printHeader();
+	s_overhead.print();
+	benchPPMOut(9, 8);
+	benchPPMOut(7, 8);
+	benchPPMOut(9, RC_MAX_CHANNELS);
+	benchServoOut();
+	return 0;
+}
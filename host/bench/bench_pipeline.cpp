@@ -0,0 +1,56 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** bench_pipeline.cpp
+** Host time spent in the transmitter example's loop()
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+// the Arduino IDE includes Arduino.h in sketches
+#include <Arduino.h>
+#include "../../examples/TX_example/tx_example.pde"
+
+#include <rc_host.h>
+
+#include "bench.h"
+
+
+enum
+{
+	Frames = 20000
+};
+
+static rc::bench::Stats s_loop("frame, TX example loop()");
+
+
+int main()
+{
+	sei();
+	setup();
+	
+	uint16_t value = 0;
+	for (uint32_t frame = 0; frame < Frames; ++frame)
+	{
+		// sweep the sticks so the mixers don't see the same values every frame
+		value = (value + 7) & 1023;
+		rc::host::setAnalog(A0, value);
+		rc::host::setAnalog(A1, 1023 - value);
+		rc::host::setAnalog(A2, value);
+		rc::host::setAnalog(A3, 1023 - value);
+		
+		uint64_t start = rc::bench::now();
+		loop();
+		uint64_t end = rc::bench::now();
+		s_loop.add(end - start);
+	}
+	
+	printf("host cycles per frame\n");
+	rc::bench::Stats::printHeader();
+	s_loop.print();
+	return 0;
+}
@@ -0,0 +1,205 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** bench_util.cpp
+** Micros/normalized conversions against the division based versions of 0.4,
+** and single value against buffer conversions
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <util.h>
+
+#include "bench.h"
+
+
+// Every conversion is checked against the 0.4 version for all inputs first,
+// a mismatch fails the benchmark. Timing samples cover a sweep of inputs
+// because a single call is too short to measure.
+
+enum
+{
+	Sweeps = 2000
+};
+
+struct Timing
+{
+	uint16_t center;
+	uint16_t travel;
+};
+
+static const Timing s_timings[] =
+{
+	{1520,  600}, // Futaba
+	{1500,  600}, // JR
+	{1500,  500},
+	{1500, 1000},
+	{1500, 1024},
+	{ 800,    4},
+	{1234,  567}
+};
+
+static rc::bench::Stats s_oldMicros("microsToNormalized, 0.4");
+static rc::bench::Stats s_newMicros("microsToNormalized");
+static rc::bench::Stats s_oldNormal("normalizedToMicros, 0.4");
+static rc::bench::Stats s_newNormal("normalizedToMicros");
+static rc::bench::Stats s_bufMicros("microsToNormalized, buffer");
+static rc::bench::Stats s_bufNormal("normalizedToMicros, buffer");
+
+static volatile int32_t  s_sink;
+static volatile uint16_t s_center = 1520; // volatile so the compiler can't fold the 0.4 division
+static volatile uint16_t s_travel = 600;
+
+
+// microsToNormalized as it was in 0.4, not inlined just like the library functions
+__attribute__((noinline)) static int16_t oldMicrosToNormalized(uint16_t p_micros, uint16_t p_center, uint16_t p_travel)
+{
+	if (p_micros >= p_center + p_travel)
+	{
+		return 256;
+	}
+	else if (p_micros <= p_center - p_travel)
+	{
+		return -256;
+	}
+	uint16_t delta = (p_micros > p_center) ? (p_micros - p_center) : (p_center - p_micros);
+	delta <<= 6;
+	delta /= (p_travel >> 2);
+	return (p_micros >= p_center) ? delta : -delta;
+}
+
+
+// normalizedToMicros as it was in 0.4
+__attribute__((noinline)) static uint16_t oldNormalizedToMicros(int16_t p_normal, uint16_t p_center, uint16_t p_travel)
+{
+	p_normal += 256;
+	uint16_t range = p_travel << 1;
+	uint16_t p1 =  p_normal       & 0x1F;
+	uint16_t p2 = (p_normal >> 5) & 0x1F;
+	p1 *= range;
+	p2 *= range;
+	p1 >>= 9;
+	p2 >>= 4;
+	return ((p_center - p_travel) + p1 + p2);
+}
+
+
+static int check(const Timing& p_timing)
+{
+	rc::setCenter(p_timing.center);
+	rc::setTravel(p_timing.travel);
+	
+	int failures = 0;
+	for (uint32_t micros = 0; micros <= 0xFFFF; ++micros)
+	{
+		int16_t expected = oldMicrosToNormalized(static_cast<uint16_t>(micros), p_timing.center, p_timing.travel);
+		int16_t actual   = rc::microsToNormalized(static_cast<uint16_t>(micros));
+		if (actual != expected && failures++ < 10)
+		{
+			printf("center %u travel %u: microsToNormalized(%u) = %d, expected %d\n",
+			       p_timing.center, p_timing.travel, static_cast<unsigned>(micros), actual, expected);
+		}
+	}
+	for (int16_t normal = -256; normal <= 256; ++normal)
+	{
+		uint16_t expected = oldNormalizedToMicros(normal, p_timing.center, p_timing.travel);
+		uint16_t actual   = rc::normalizedToMicros(normal);
+		if (actual != expected && failures++ < 10)
+		{
+			printf("center %u travel %u: normalizedToMicros(%d) = %u, expected %u\n",
+			       p_timing.center, p_timing.travel, normal, actual, expected);
+		}
+	}
+	return failures;
+}
+
+
+int main()
+{
+	int failures = 0;
+	for (uint8_t i = 0; i < sizeof(s_timings) / sizeof(s_timings[0]); ++i)
+	{
+		failures += check(s_timings[i]);
+	}
+	printf("identical output for all inputs: %s\n", failures == 0 ? "yes" : "NO");
+	
+	// inputs for the buffer versions, the same as the single value sweeps below
+	uint16_t micros[248];
+	int16_t normalized[248];
+	for (uint16_t i = 0; i < 248; ++i)
+	{
+		micros[i] = 900 + i * 5;
+	}
+	int16_t normals[257];
+	uint16_t outMicros[257];
+	for (uint16_t i = 0; i < 257; ++i)
+	{
+		normals[i] = static_cast<int16_t>(i * 2) - 256;
+	}
+	
+	rc::loadFutaba();
+	for (uint16_t sweep = 0; sweep < Sweeps; ++sweep)
+	{
+		int32_t sum = 0;
+		uint64_t start = rc::bench::now();
+		for (uint16_t micros = 900; micros < 2140; micros += 5)
+		{
+			sum += oldMicrosToNormalized(micros, s_center, s_travel);
+		}
+		uint64_t end = rc::bench::now();
+		s_oldMicros.add(end - start);
+		
+		start = rc::bench::now();
+		for (uint16_t micros = 900; micros < 2140; micros += 5)
+		{
+			sum += rc::microsToNormalized(micros);
+		}
+		end = rc::bench::now();
+		s_newMicros.add(end - start);
+		
+		start = rc::bench::now();
+		for (int16_t normal = -256; normal <= 256; normal += 2)
+		{
+			sum += oldNormalizedToMicros(normal, s_center, s_travel);
+		}
+		end = rc::bench::now();
+		s_oldNormal.add(end - start);
+		
+		start = rc::bench::now();
+		for (int16_t normal = -256; normal <= 256; normal += 2)
+		{
+			sum += rc::normalizedToMicros(normal);
+		}
+		end = rc::bench::now();
+		s_newNormal.add(end - start);
+		
+		start = rc::bench::now();
+		rc::microsToNormalized(micros, normalized, 248);
+		end = rc::bench::now();
+		s_bufMicros.add(end - start);
+		
+		start = rc::bench::now();
+		rc::normalizedToMicros(normals, outMicros, 255);
+		rc::normalizedToMicros(normals + 255, outMicros + 255, 2);
+		end = rc::bench::now();
+		s_bufNormal.add(end - start);
+		
+		s_sink = sum + normalized[sweep % 248] + outMicros[sweep % 257];
+	}
+	
+	printf("host cycles per sweep of 248 (micros) or 257 (normalized) conversions\n");
+	rc::bench::Stats::printHeader();
+	s_oldMicros.print();
+	s_newMicros.print();
+	s_bufMicros.print();
+	s_oldNormal.print();
+	s_newNormal.print();
+	s_bufNormal.print();
+	return failures == 0 ? 0 : 1;
+}
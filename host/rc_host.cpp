@@ -0,0 +1,1040 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_host.cpp
+** Simulated Atmega328p for running the library on a host machine
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <string.h>
+
+#include <Arduino.h>
+
+#include <rc_host.h>
+
+
+extern "C"
+{
+	volatile uint8_t rc_host_sfr[0x100] = { 0 };
+	volatile uint8_t rc_host_pin[3] = { 0 };
+}
+
+
+// Default vectors, the library supplies the ones it uses
+extern "C"
+{
+	void __attribute__((weak)) INT0_vect(void) {}
+	void __attribute__((weak)) INT1_vect(void) {}
+	void __attribute__((weak)) PCINT0_vect(void) {}
+	void __attribute__((weak)) PCINT1_vect(void) {}
+	void __attribute__((weak)) PCINT2_vect(void) {}
+	void __attribute__((weak)) TIMER2_COMPA_vect(void) {}
+	void __attribute__((weak)) TIMER2_COMPB_vect(void) {}
+	void __attribute__((weak)) TIMER2_OVF_vect(void) {}
+	void __attribute__((weak)) TIMER1_CAPT_vect(void) {}
+	void __attribute__((weak)) TIMER1_COMPA_vect(void) {}
+	void __attribute__((weak)) TIMER1_COMPB_vect(void) {}
+	void __attribute__((weak)) TIMER1_OVF_vect(void) {}
+	void __attribute__((weak)) USART_RX_vect(void) {}
+	void __attribute__((weak)) USART_UDRE_vect(void) {}
+	void __attribute__((weak)) USART_TX_vect(void) {}
+	void __attribute__((weak)) ADC_vect(void) {}
+}
+
+
+namespace rc {
+namespace host {
+
+enum
+{
+	Ports = 3, //!< Ports B, C and D
+
+	CyclesPerMilli = F_CPU / 1000,
+	CyclesPerMicro = F_CPU / 1000000
+};
+
+static uint64_t s_cycles = 0;        //!< CPU cycles since reset.
+static uint16_t s_t1Residual = 0;    //!< CPU cycles since the last Timer1 tick.
+static uint16_t s_t2Residual = 0;    //!< CPU cycles since the last Timer2 tick.
+static uint16_t s_ocr1a = 0;         //!< OCR1A as used by the compare unit (double buffered in PWM modes).
+static uint16_t s_ocr1b = 0;         //!< OCR1B as used by the compare unit (double buffered in PWM modes).
+static bool     s_oc1a = false;      //!< Level of the OC1A compare output.
+static bool     s_oc1b = false;      //!< Level of the OC1B compare output.
+static bool     s_oc2a = false;      //!< Level of the OC2A compare output.
+static bool     s_oc2b = false;      //!< Level of the OC2B compare output.
+static uint8_t  s_external[Ports] = { 0 }; //!< Levels driven from outside the chip.
+static uint16_t s_analog[8] = { 0 };       //!< Values returned by analogRead and the ADC.
+static bool     s_adcOn = false;           //!< Whether the ADC has been enabled, the first conversion takes longer.
+static bool     s_adcBusy = false;         //!< Whether a conversion is in progress.
+static uint8_t  s_adcMux = 0;              //!< Channel being converted, latched at the start.
+static uint64_t s_adcEnd = 0;              //!< Cycle at which the conversion is done.
+static Edge     s_edges[MaxEdges];         //!< Edge log.
+static uint16_t s_edgeCount = 0;           //!< Number of edges in the log.
+static uint8_t  s_wireFrom[MaxWires];      //!< Pins driving a wire.
+static uint8_t  s_wireTo[MaxWires];        //!< Pins driven by a wire.
+static uint8_t  s_wireCount = 0;           //!< Number of wires.
+static uint8_t  s_txBuffer = 0;            //!< UART transmit buffer (UDR0).
+static bool     s_txFull = false;          //!< Whether the transmit buffer holds a byte.
+static uint8_t  s_txShift = 0;             //!< Byte in the transmit shift register.
+static bool     s_txBusy = false;          //!< Whether the shift register is sending.
+static uint64_t s_txEnd = 0;               //!< Cycle at which the shift register is done.
+static uint8_t  s_rxBuffer = 0;            //!< UART receive buffer (UDR0).
+static bool     s_uartLoopback = false;    //!< Whether sent bytes are received as well.
+static UartByte s_uartBytes[MaxUartBytes]; //!< UART log.
+static uint16_t s_uartByteCount = 0;       //!< Number of bytes in the UART log.
+
+
+static uint8_t pinToPort(uint8_t p_pin)
+{
+	return p_pin < 20 ? digitalPinToPort(p_pin) - PB : 0;
+}
+
+
+static uint8_t portToPin(uint8_t p_port, uint8_t p_bit)
+{
+	switch (p_port)
+	{
+	case 0:  return p_bit + 8;
+	case 1:  return p_bit + 14;
+	default: return p_bit;
+	}
+}
+
+
+static volatile uint8_t& strobeReg(uint8_t p_port)
+{
+	return rc_host_sfr[0x23 + p_port * 3];
+}
+
+
+static volatile uint8_t& ddrReg(uint8_t p_port)
+{
+	return rc_host_sfr[0x24 + p_port * 3];
+}
+
+
+static volatile uint8_t& portReg(uint8_t p_port)
+{
+	return rc_host_sfr[0x25 + p_port * 3];
+}
+
+
+static uint16_t getTimer1Prescaler()
+{
+	static const uint16_t s_prescalers[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+	return s_prescalers[TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10))];
+}
+
+
+static uint16_t getTimer2Prescaler()
+{
+	static const uint16_t s_prescalers[8] = { 0, 1, 8, 32, 64, 128, 256, 1024 };
+	return s_prescalers[TCCR2B & (_BV(CS22) | _BV(CS21) | _BV(CS20))];
+}
+
+
+static uint8_t getTimer1Mode()
+{
+	return (TCCR1A & (_BV(WGM11) | _BV(WGM10))) | ((TCCR1B & (_BV(WGM13) | _BV(WGM12))) >> 1);
+}
+
+
+static bool timer1IsPWM()
+{
+	uint8_t mode = getTimer1Mode();
+	return mode != 0 && mode != 4 && mode != 12;
+}
+
+
+static uint16_t getTimer1Top()
+{
+	switch (getTimer1Mode())
+	{
+	case 4:
+	case 15: return OCR1A;
+	case 12:
+	case 14: return ICR1;
+	default: return 0xFFFF;
+	}
+}
+
+
+static uint8_t getTimer2Top()
+{
+	return (TCCR2A & _BV(WGM21)) ? OCR2A : 0xFF;
+}
+
+
+// Number of ticks until a counter at p_count reaches p_value, counting up to p_top
+static uint32_t ticksUntil(uint16_t p_count, uint16_t p_value, uint16_t p_top)
+{
+	if (p_value > p_top)
+	{
+		return 0x20000; // never
+	}
+	if (p_value > p_count)
+	{
+		return p_value - p_count;
+	}
+	return static_cast<uint32_t>(p_top) + 1 - p_count + p_value;
+}
+
+
+static void logEdge(uint8_t p_pin, bool p_high)
+{
+	if (s_edgeCount < MaxEdges)
+	{
+		s_edges[s_edgeCount].cycle = static_cast<uint32_t>(s_cycles);
+		s_edges[s_edgeCount].pin   = p_pin;
+		s_edges[s_edgeCount].high  = p_high;
+		++s_edgeCount;
+	}
+}
+
+
+static void applyCompareOutput(bool& p_level, uint8_t p_com, bool p_pwm)
+{
+	switch (p_com)
+	{
+	case 1: p_level = p_pwm ? p_level : !p_level; break;
+	case 2: p_level = false; break;
+	case 3: p_level = true;  break;
+	default: break;
+	}
+}
+
+
+static void updatePorts()
+{
+	for (uint8_t port = 0; port < Ports; ++port)
+	{
+		// handle writes to PINx, these toggle PORTx
+		uint8_t strobe = strobeReg(port);
+		if (strobe != 0)
+		{
+			strobeReg(port) = 0;
+			portReg(port) ^= strobe;
+		}
+
+		uint8_t ddr   = ddrReg(port);
+		uint8_t level = (portReg(port) & ddr) | (s_external[port] & ~ddr);
+
+		// compare outputs override the port
+		if (port == 0)
+		{
+			if ((TCCR1A & (_BV(COM1A1) | _BV(COM1A0))) && (ddr & _BV(1)))
+			{
+				level = s_oc1a ? (level | _BV(1)) : (level & ~_BV(1));
+			}
+			if ((TCCR1A & (_BV(COM1B1) | _BV(COM1B0))) && (ddr & _BV(2)))
+			{
+				level = s_oc1b ? (level | _BV(2)) : (level & ~_BV(2));
+			}
+			if ((TCCR2A & (_BV(COM2A1) | _BV(COM2A0))) && (ddr & _BV(3)))
+			{
+				level = s_oc2a ? (level | _BV(3)) : (level & ~_BV(3));
+			}
+		}
+		else if (port == 2)
+		{
+			if ((TCCR2A & (_BV(COM2B1) | _BV(COM2B0))) && (ddr & _BV(3)))
+			{
+				level = s_oc2b ? (level | _BV(3)) : (level & ~_BV(3));
+			}
+		}
+
+		uint8_t changed = level ^ rc_host_pin[port];
+		if (changed == 0)
+		{
+			continue;
+		}
+		uint8_t rising = changed & level;
+		rc_host_pin[port] = level;
+
+		for (uint8_t bit = 0; bit < 8; ++bit)
+		{
+			if (changed & _BV(bit))
+			{
+				logEdge(portToPin(port, bit), (level & _BV(bit)) != 0);
+			}
+		}
+
+		// input capture on ICP1 (PB0), not in modes 12 and 14 where ICR1 is TOP
+		if (port == 0 && (changed & _BV(0)))
+		{
+			uint8_t mode = getTimer1Mode();
+			bool    rise = (rising & _BV(0)) != 0;
+			if (mode != 12 && mode != 14 && rise == ((TCCR1B & _BV(ICES1)) != 0))
+			{
+				ICR1 = TCNT1;
+				TIFR1 |= _BV(ICF1);
+			}
+		}
+
+		// pin change interrupts
+		static volatile uint8_t* const s_pcmsk[Ports] = { &PCMSK0, &PCMSK1, &PCMSK2 };
+		if (changed & *s_pcmsk[port])
+		{
+			PCIFR |= _BV(port);
+		}
+
+		// external interrupts on PD2 and PD3
+		if (port == 2)
+		{
+			for (uint8_t i = 0; i < 2; ++i)
+			{
+				uint8_t mask = _BV(2 + i);
+				if ((changed & mask) == 0)
+				{
+					continue;
+				}
+				uint8_t isc = (EICRA >> (i * 2)) & 0x03;
+				if (isc == 1 ||
+				   (isc == 2 && (rising & mask) == 0) ||
+				   (isc == 3 && (rising & mask) != 0) ||
+				   (isc == 0 && (level & mask) == 0))
+				{
+					EIFR |= _BV(i);
+				}
+			}
+		}
+	}
+}
+
+
+static void updateLevels()
+{
+	updatePorts();
+	
+	// propagate levels over wires, a wire may drive a pin which drives another wire
+	for (uint8_t pass = 0; pass < MaxWires; ++pass)
+	{
+		bool changed = false;
+		for (uint8_t i = 0; i < s_wireCount; ++i)
+		{
+			uint8_t from = pinToPort(s_wireFrom[i]);
+			uint8_t to   = pinToPort(s_wireTo[i]);
+			uint8_t mask = digitalPinToBitMask(s_wireTo[i]);
+			uint8_t ext  = (rc_host_pin[from] & digitalPinToBitMask(s_wireFrom[i])) ?
+			               (s_external[to] | mask) : (s_external[to] & ~mask);
+			if (ext != s_external[to])
+			{
+				s_external[to] = ext;
+				changed = true;
+			}
+		}
+		if (changed == false)
+		{
+			return;
+		}
+		updatePorts();
+	}
+}
+
+
+// Cycles needed to send one UART frame: start bit, data bits, parity and stop bits
+static uint32_t getUartFrameCycles()
+{
+	uint16_t ubrr = (static_cast<uint16_t>(UBRR0H & 0x0F) << 8) | UBRR0L;
+	uint8_t  bits = 1 + 5 + ((UCSR0C >> UCSZ00) & 0x03);
+	if (UCSR0C & _BV(UPM01))
+	{
+		++bits;
+	}
+	bits += (UCSR0C & _BV(USBS0)) ? 2 : 1;
+	return static_cast<uint32_t>(bits) * ((UCSR0A & _BV(U2X0)) ? 8 : 16) * (ubrr + 1);
+}
+
+
+// UDRE0 is read only, it follows the transmit buffer whatever the code writes to UCSR0A
+static void updateUartFlags()
+{
+	UCSR0A = s_txFull ? (UCSR0A & ~_BV(UDRE0)) : (UCSR0A | _BV(UDRE0));
+}
+
+
+static uint32_t uartDistance(uint32_t p_max)
+{
+	if (s_txBusy == false)
+	{
+		return p_max;
+	}
+	uint64_t cycles = s_txEnd - s_cycles;
+	return cycles < p_max ? static_cast<uint32_t>(cycles) : p_max;
+}
+
+
+static void stepUart()
+{
+	if (s_txBusy == false || s_cycles < s_txEnd)
+	{
+		return;
+	}
+
+	uint8_t data = s_txShift;
+	if (s_uartByteCount < MaxUartBytes)
+	{
+		s_uartBytes[s_uartByteCount].cycle = static_cast<uint32_t>(s_cycles);
+		s_uartBytes[s_uartByteCount].data  = data;
+		++s_uartByteCount;
+	}
+
+	if (s_txFull)
+	{
+		s_txShift = s_txBuffer;
+		s_txFull  = false;
+		s_txEnd  += getUartFrameCycles();
+	}
+	else
+	{
+		s_txBusy = false;
+		UCSR0A |= _BV(TXC0);
+	}
+	updateUartFlags();
+
+	if (s_uartLoopback)
+	{
+		uartReceive(data);
+	}
+}
+
+
+// Cycles until the conversion in progress is done, starts a conversion if ADSC has been set
+static uint32_t adcDistance(uint32_t p_max)
+{
+	if ((ADCSRA & _BV(ADEN)) == 0)
+	{
+		s_adcOn   = false;
+		s_adcBusy = false;
+		ADCSRA &= ~_BV(ADSC);
+		return p_max;
+	}
+	if (s_adcBusy == false && (ADCSRA & _BV(ADSC)))
+	{
+		static const uint8_t s_prescalers[8] = { 2, 2, 4, 8, 16, 32, 64, 128 };
+		uint8_t clocks = s_adcOn ? 13 : 25;
+		s_adcOn   = true;
+		s_adcBusy = true;
+		s_adcMux  = ADMUX & 0x0F;
+		s_adcEnd  = s_cycles + static_cast<uint32_t>(clocks) * s_prescalers[ADCSRA & 0x07];
+	}
+	if (s_adcBusy == false)
+	{
+		return p_max;
+	}
+	uint64_t cycles = s_adcEnd - s_cycles;
+	return cycles < p_max ? static_cast<uint32_t>(cycles) : p_max;
+}
+
+
+static void stepAdc()
+{
+	if (s_adcBusy == false || s_cycles < s_adcEnd)
+	{
+		return;
+	}
+	uint16_t value = s_adcMux < 8 ? s_analog[s_adcMux] : 0;
+	ADC = (ADMUX & _BV(ADLAR)) ? (value << 6) : value;
+	ADCSRA = (ADCSRA & ~_BV(ADSC)) | _BV(ADIF);
+	s_adcBusy = false;
+}
+
+
+static void callVector(void (*p_vector)(void))
+{
+	// the hardware clears the I flag on interrupt entry and RETI sets it again
+	SREG &= ~_BV(SREG_I);
+	p_vector();
+	SREG |= _BV(SREG_I);
+	updateLevels();
+}
+
+
+// Calls vectors of all pending and enabled interrupts, in order of priority
+static void dispatch()
+{
+	updateLevels();
+	updateUartFlags();
+	for (;;)
+	{
+		if ((SREG & _BV(SREG_I)) == 0)
+		{
+			return;
+		}
+
+		uint8_t ext = EIFR & EIMSK;
+		uint8_t pc  = PCIFR & PCICR;
+		uint8_t t2  = TIFR2 & TIMSK2;
+		uint8_t t1  = TIFR1 & TIMSK1;
+		uint8_t u0  = UCSR0A & UCSR0B; // flags and their interrupt enables share bit positions
+		bool    adc = (ADCSRA & _BV(ADIF)) && (ADCSRA & _BV(ADIE));
+
+		if      (ext & _BV(INT0))   { EIFR  &= ~_BV(INT0);   callVector(INT0_vect); }
+		else if (ext & _BV(INT1))   { EIFR  &= ~_BV(INT1);   callVector(INT1_vect); }
+		else if (pc  & _BV(PCIE0))  { PCIFR &= ~_BV(PCIE0);  callVector(PCINT0_vect); }
+		else if (pc  & _BV(PCIE1))  { PCIFR &= ~_BV(PCIE1);  callVector(PCINT1_vect); }
+		else if (pc  & _BV(PCIE2))  { PCIFR &= ~_BV(PCIE2);  callVector(PCINT2_vect); }
+		else if (t2  & _BV(OCF2A))  { TIFR2 &= ~_BV(OCF2A);  callVector(TIMER2_COMPA_vect); }
+		else if (t2  & _BV(OCF2B))  { TIFR2 &= ~_BV(OCF2B);  callVector(TIMER2_COMPB_vect); }
+		else if (t2  & _BV(TOV2))   { TIFR2 &= ~_BV(TOV2);   callVector(TIMER2_OVF_vect); }
+		else if (t1  & _BV(ICF1))   { TIFR1 &= ~_BV(ICF1);   callVector(TIMER1_CAPT_vect); }
+		else if (t1  & _BV(OCF1A))  { TIFR1 &= ~_BV(OCF1A);  callVector(TIMER1_COMPA_vect); }
+		else if (t1  & _BV(OCF1B))  { TIFR1 &= ~_BV(OCF1B);  callVector(TIMER1_COMPB_vect); }
+		else if (t1  & _BV(TOV1))   { TIFR1 &= ~_BV(TOV1);   callVector(TIMER1_OVF_vect); }
+		else if (u0  & _BV(RXC0))   { callVector(USART_RX_vect); }   // cleared by reading UDR0
+		else if (u0  & _BV(UDRE0))  { callVector(USART_UDRE_vect); } // cleared by writing UDR0
+		else if (u0  & _BV(TXC0))   { UCSR0A &= ~_BV(TXC0);  callVector(USART_TX_vect); }
+		else if (adc)               { ADCSRA &= ~_BV(ADIF);  callVector(ADC_vect); }
+		else
+		{
+			return;
+		}
+	}
+}
+
+
+// Cycles until the next Timer1 event, or p_max if nothing happens before that
+static uint32_t timer1Distance(uint32_t p_max)
+{
+	uint16_t prescaler = getTimer1Prescaler();
+	if (prescaler == 0)
+	{
+		return p_max;
+	}
+	if (timer1IsPWM() == false)
+	{
+		s_ocr1a = OCR1A;
+		s_ocr1b = OCR1B;
+	}
+	uint16_t top = getTimer1Top();
+	uint16_t cnt = TCNT1;
+	uint32_t ticks = ticksUntil(cnt, 0, top);
+	uint32_t t = ticksUntil(cnt, s_ocr1a, top);
+	if (t < ticks) ticks = t;
+	t = ticksUntil(cnt, s_ocr1b, top);
+	if (t < ticks) ticks = t;
+
+	uint64_t cycles = static_cast<uint64_t>(ticks) * prescaler - s_t1Residual;
+	return cycles < p_max ? static_cast<uint32_t>(cycles) : p_max;
+}
+
+
+static uint32_t timer2Distance(uint32_t p_max)
+{
+	uint16_t prescaler = getTimer2Prescaler();
+	if (prescaler == 0)
+	{
+		return p_max;
+	}
+	uint8_t  top = getTimer2Top();
+	uint8_t  cnt = TCNT2;
+	uint32_t ticks = ticksUntil(cnt, 0, top);
+	uint32_t t = ticksUntil(cnt, OCR2A, top);
+	if (t < ticks) ticks = t;
+	t = ticksUntil(cnt, OCR2B, top);
+	if (t < ticks) ticks = t;
+
+	uint64_t cycles = static_cast<uint64_t>(ticks) * prescaler - s_t2Residual;
+	return cycles < p_max ? static_cast<uint32_t>(cycles) : p_max;
+}
+
+
+static void stepTimer1(uint32_t p_cycles)
+{
+	uint16_t prescaler = getTimer1Prescaler();
+	if (prescaler == 0)
+	{
+		return;
+	}
+	uint32_t total = s_t1Residual + p_cycles;
+	uint32_t ticks = total / prescaler;
+	s_t1Residual = static_cast<uint16_t>(total % prescaler);
+	if (ticks == 0)
+	{
+		return;
+	}
+
+	// timer1Distance guarantees we hit at most one event tick, and only at the end
+	uint16_t top  = getTimer1Top();
+	uint32_t next = static_cast<uint32_t>(TCNT1) + ticks;
+	bool     pwm  = timer1IsPWM();
+	if (next > top)
+	{
+		TCNT1 = static_cast<uint16_t>(next - top - 1);
+		if (getTimer1Mode() == 12)
+		{
+			TIFR1 |= _BV(ICF1);
+		}
+		if (top == 0xFFFF || pwm)
+		{
+			TIFR1 |= _BV(TOV1);
+		}
+		if (pwm)
+		{
+			// update double buffered compare registers and set outputs at BOTTOM
+			s_ocr1a = OCR1A;
+			s_ocr1b = OCR1B;
+			uint8_t comA = (TCCR1A >> COM1A0) & 0x03;
+			uint8_t comB = (TCCR1A >> COM1B0) & 0x03;
+			if (comA >= 2) s_oc1a = (comA == 2);
+			if (comB >= 2) s_oc1b = (comB == 2);
+		}
+	}
+	else
+	{
+		TCNT1 = static_cast<uint16_t>(next);
+	}
+
+	uint16_t cnt = TCNT1;
+	if (cnt == s_ocr1a)
+	{
+		TIFR1 |= _BV(OCF1A);
+		applyCompareOutput(s_oc1a, (TCCR1A >> COM1A0) & 0x03, pwm);
+	}
+	if (cnt == s_ocr1b)
+	{
+		TIFR1 |= _BV(OCF1B);
+		applyCompareOutput(s_oc1b, (TCCR1A >> COM1B0) & 0x03, pwm);
+	}
+}
+
+
+static void stepTimer2(uint32_t p_cycles)
+{
+	uint16_t prescaler = getTimer2Prescaler();
+	if (prescaler == 0)
+	{
+		return;
+	}
+	uint32_t total = s_t2Residual + p_cycles;
+	uint32_t ticks = total / prescaler;
+	s_t2Residual = static_cast<uint16_t>(total % prescaler);
+	if (ticks == 0)
+	{
+		return;
+	}
+
+	uint8_t  top  = getTimer2Top();
+	uint32_t next = static_cast<uint32_t>(TCNT2) + ticks;
+	if (next > top)
+	{
+		TCNT2 = static_cast<uint8_t>(next - top - 1);
+		if (top == 0xFF)
+		{
+			TIFR2 |= _BV(TOV2);
+		}
+	}
+	else
+	{
+		TCNT2 = static_cast<uint8_t>(next);
+	}
+
+	uint8_t cnt = TCNT2;
+	if (cnt == OCR2A)
+	{
+		TIFR2 |= _BV(OCF2A);
+		applyCompareOutput(s_oc2a, (TCCR2A >> COM2A0) & 0x03, false);
+	}
+	if (cnt == OCR2B)
+	{
+		TIFR2 |= _BV(OCF2B);
+		applyCompareOutput(s_oc2b, (TCCR2A >> COM2B0) & 0x03, false);
+	}
+}
+
+
+// Public functions
+
+void reset()
+{
+	for (uint16_t i = 0; i < sizeof(rc_host_sfr); ++i)
+	{
+		rc_host_sfr[i] = 0;
+	}
+	for (uint8_t i = 0; i < Ports; ++i)
+	{
+		rc_host_pin[i] = 0;
+		s_external[i]  = 0;
+	}
+	for (uint8_t i = 0; i < 8; ++i)
+	{
+		s_analog[i] = 0;
+	}
+	s_cycles     = 0;
+	s_t1Residual = 0;
+	s_t2Residual = 0;
+	s_ocr1a      = 0;
+	s_ocr1b      = 0;
+	s_oc1a       = false;
+	s_oc1b       = false;
+	s_oc2a       = false;
+	s_oc2b       = false;
+	s_edgeCount  = 0;
+	s_wireCount  = 0;
+
+	s_txBuffer      = 0;
+	s_txFull        = false;
+	s_txShift       = 0;
+	s_txBusy        = false;
+	s_txEnd         = 0;
+	s_rxBuffer      = 0;
+	s_uartLoopback  = false;
+	s_uartByteCount = 0;
+
+	s_adcOn   = false;
+	s_adcBusy = false;
+	s_adcMux  = 0;
+	s_adcEnd  = 0;
+
+	// the Arduino core enables interrupts before setup() is called
+	SREG = _BV(SREG_I);
+}
+
+
+uint32_t getCycles()
+{
+	return static_cast<uint32_t>(s_cycles);
+}
+
+
+void advance(uint32_t p_cycles)
+{
+	dispatch();
+	while (p_cycles > 0)
+	{
+		uint32_t step = timer1Distance(p_cycles);
+		step = timer2Distance(step);
+		step = uartDistance(step);
+		step = adcDistance(step);
+
+		s_cycles += step;
+		p_cycles -= step;
+		stepTimer1(step);
+		stepTimer2(step);
+		stepUart();
+		stepAdc();
+
+		dispatch();
+	}
+}
+
+
+void advanceMicros(uint32_t p_micros)
+{
+	advance(p_micros * CyclesPerMicro);
+}
+
+
+void setPin(uint8_t p_pin, bool p_high)
+{
+	uint8_t port = pinToPort(p_pin);
+	uint8_t mask = digitalPinToBitMask(p_pin);
+	s_external[port] = p_high ? (s_external[port] | mask) : (s_external[port] & ~mask);
+	dispatch();
+}
+
+
+bool getPin(uint8_t p_pin)
+{
+	updateLevels();
+	return (rc_host_pin[pinToPort(p_pin)] & digitalPinToBitMask(p_pin)) != 0;
+}
+
+
+void connect(uint8_t p_from, uint8_t p_to)
+{
+	if (s_wireCount < MaxWires)
+	{
+		s_wireFrom[s_wireCount] = p_from;
+		s_wireTo[s_wireCount]   = p_to;
+		++s_wireCount;
+	}
+	dispatch();
+}
+
+
+void setAnalog(uint8_t p_pin, uint16_t p_value)
+{
+	s_analog[(p_pin >= A0 ? p_pin - A0 : p_pin) & 0x07] = p_value & 0x3FF;
+}
+
+
+void sync()
+{
+	dispatch();
+}
+
+
+uint16_t getEdgeCount()
+{
+	return s_edgeCount;
+}
+
+
+const Edge& getEdge(uint16_t p_index)
+{
+	return s_edges[p_index < s_edgeCount ? p_index : 0];
+}
+
+
+void clearEdges()
+{
+	s_edgeCount = 0;
+}
+
+
+void uartReceive(uint8_t p_byte, bool p_error)
+{
+	if ((UCSR0B & _BV(RXEN0)) == 0)
+	{
+		return;
+	}
+	uint8_t status = UCSR0A & ~(_BV(FE0) | _BV(DOR0) | _BV(UPE0));
+	if (UCSR0A & _BV(RXC0))
+	{
+		status |= _BV(DOR0);
+	}
+	if (p_error)
+	{
+		status |= _BV(FE0);
+	}
+	UCSR0A = status | _BV(RXC0);
+	s_rxBuffer = p_byte;
+	dispatch();
+}
+
+
+void setUartLoopback(bool p_loopback)
+{
+	s_uartLoopback = p_loopback;
+}
+
+
+uint16_t getUartByteCount()
+{
+	return s_uartByteCount;
+}
+
+
+const UartByte& getUartByte(uint16_t p_index)
+{
+	return s_uartBytes[p_index < s_uartByteCount ? p_index : 0];
+}
+
+
+void clearUartBytes()
+{
+	s_uartByteCount = 0;
+}
+
+
+// namespace end
+}
+}
+
+
+// USART data register
+
+volatile rc_host_udr rc_host_udr0;
+
+
+void rc_host_udr::operator=(uint8_t p_value) volatile
+{
+	using namespace rc::host;
+	if ((UCSR0B & _BV(TXEN0)) == 0)
+	{
+		return;
+	}
+	if (s_txBusy == false)
+	{
+		// an empty shift register takes the byte right away
+		s_txShift = p_value;
+		s_txBusy  = true;
+		s_txEnd   = s_cycles + getUartFrameCycles();
+	}
+	else
+	{
+		// a full buffer is overwritten, like on the chip
+		s_txBuffer = p_value;
+		s_txFull   = true;
+	}
+	UCSR0A &= ~_BV(TXC0);
+	updateUartFlags();
+}
+
+
+rc_host_udr::operator uint8_t() volatile
+{
+	UCSR0A &= ~(_BV(RXC0) | _BV(FE0) | _BV(DOR0) | _BV(UPE0));
+	return rc::host::s_rxBuffer;
+}
+
+
+// Timer1 Force Output Compare
+
+volatile rc_host_foc rc_host_tccr1c;
+
+
+void rc_host_foc::operator=(uint8_t p_value) volatile
+{
+	using namespace rc::host;
+	
+	// a forced compare match sets the outputs like a real one, without a flag, not in PWM modes
+	if (timer1IsPWM())
+	{
+		return;
+	}
+	if (p_value & _BV(FOC1A))
+	{
+		applyCompareOutput(s_oc1a, (TCCR1A >> COM1A0) & 0x03, false);
+	}
+	if (p_value & _BV(FOC1B))
+	{
+		applyCompareOutput(s_oc1b, (TCCR1A >> COM1B0) & 0x03, false);
+	}
+}
+
+
+// Arduino core
+
+void pinMode(uint8_t p_pin, uint8_t p_mode)
+{
+	uint8_t port = digitalPinToPort(p_pin);
+	uint8_t mask = digitalPinToBitMask(p_pin);
+	if (port == NOT_A_PORT)
+	{
+		return;
+	}
+	volatile uint8_t* ddr = portModeRegister(port);
+	volatile uint8_t* out = portOutputRegister(port);
+	if (p_mode == OUTPUT)
+	{
+		*ddr |= mask;
+	}
+	else
+	{
+		*ddr &= ~mask;
+		*out = (p_mode == INPUT_PULLUP) ? (*out | mask) : (*out & ~mask);
+	}
+	rc::host::sync();
+}
+
+
+void digitalWrite(uint8_t p_pin, uint8_t p_value)
+{
+	uint8_t port = digitalPinToPort(p_pin);
+	uint8_t mask = digitalPinToBitMask(p_pin);
+	if (port == NOT_A_PORT)
+	{
+		return;
+	}
+	volatile uint8_t* out = portOutputRegister(port);
+	*out = (p_value == LOW) ? (*out & ~mask) : (*out | mask);
+	rc::host::sync();
+}
+
+
+int digitalRead(uint8_t p_pin)
+{
+	if (digitalPinToPort(p_pin) == NOT_A_PORT)
+	{
+		return LOW;
+	}
+	return rc::host::getPin(p_pin) ? HIGH : LOW;
+}
+
+
+int analogRead(uint8_t p_pin)
+{
+	return rc::host::s_analog[(p_pin >= A0 ? p_pin - A0 : p_pin) & 0x07];
+}
+
+
+unsigned long millis()
+{
+	return static_cast<unsigned long>(rc::host::s_cycles / rc::host::CyclesPerMilli);
+}
+
+
+unsigned long micros()
+{
+	return static_cast<unsigned long>(rc::host::s_cycles / rc::host::CyclesPerMicro);
+}
+
+
+void delay(unsigned long p_ms)
+{
+	while (p_ms > 0)
+	{
+		rc::host::advance(rc::host::CyclesPerMilli);
+		--p_ms;
+	}
+}
+
+
+void delayMicroseconds(unsigned int p_us)
+{
+	rc::host::advanceMicros(p_us);
+}
+
+
+long map(long p_x, long p_inMin, long p_inMax, long p_outMin, long p_outMax)
+{
+	return (p_x - p_inMin) * (p_outMax - p_outMin) / (p_inMax - p_inMin) + p_outMin;
+}
+
+
+// avr-libc program space stdio
+
+int vfprintf_P(FILE* p_stream, const char* p_fmt, va_list p_args)
+{
+	// %S prints a string from program space, which is %s on the host
+	char fmt[256];
+	size_t len = 0;
+	bool spec = false; // inside a conversion specification
+	for (const char* c = p_fmt; *c != 0 && len < sizeof(fmt) - 1; ++c)
+	{
+		fmt[len] = *c;
+		if (spec == false)
+		{
+			spec = *c == '%';
+		}
+		else if (*c == 'S')
+		{
+			fmt[len] = 's';
+			spec = false;
+		}
+		else if (strchr("-+ #0123456789.*hlLjzt", *c) == 0)
+		{
+			spec = false; // conversion, or the second % of %%
+		}
+		++len;
+	}
+	fmt[len] = 0;
+	return vfprintf(p_stream, fmt, p_args);
+}
+
+
+int fprintf_P(FILE* p_stream, const char* p_fmt, ...)
+{
+	va_list vlist;
+	va_start(vlist, p_fmt);
+	int result = vfprintf_P(p_stream, p_fmt, vlist);
+	va_end(vlist);
+	return result;
+}
+
+
+int printf_P(const char* p_fmt, ...)
+{
+	va_list vlist;
+	va_start(vlist, p_fmt);
+	int result = vfprintf_P(stdout, p_fmt, vlist);
+	va_end(vlist);
+	return result;
+}
@@ -0,0 +1,134 @@
+#ifndef INC_RC_HOST_H
+#define INC_RC_HOST_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_host.h
+** Simulated Atmega328p for running the library on a host machine
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+/*!
+ *  \file      rc_host.h
+ *  \brief     Simulated Atmega328p for running the library on a host machine.
+ *  \details   The host build compiles the library against a simulated register file.
+ *             Time only moves when advance() is called; timers count, compare outputs
+ *             toggle and interrupt vectors are called as if the code ran on the chip,
+ *             but the code itself takes no time to execute.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+*/
+
+namespace rc {
+namespace host {
+
+	/*! \brief Logged change of a pin level.*/
+	struct Edge
+	{
+		uint32_t cycle; //!< CPU cycle at which the pin changed.
+		uint8_t  pin;   //!< Hardware pin that changed.
+		bool     high;  //!< New level of the pin.
+	};
+	
+	/*! \brief Logged byte sent by the UART.*/
+	struct UartByte
+	{
+		uint32_t cycle; //!< CPU cycle at which the last stop bit ended.
+		uint8_t  data;  //!< Byte sent.
+	};
+
+	enum
+	{
+		MaxEdges     = 4096, //!< Number of edges kept in the edge log.
+		MaxWires     = 8,    //!< Number of pins that can be connected to each other.
+		MaxUartBytes = 1024  //!< Number of bytes kept in the UART log.
+	};
+
+	/*! \brief Resets registers, clock, pin levels and the edge log, enables interrupts.*/
+	void reset();
+
+	/*! \brief Gets the number of CPU cycles since reset.
+	    \return CPU cycles since reset, 16 cycles per microsecond.*/
+	uint32_t getCycles();
+
+	/*! \brief Runs the simulated hardware.
+	    \param p_cycles Number of CPU cycles to advance the clock.*/
+	void advance(uint32_t p_cycles);
+
+	/*! \brief Runs the simulated hardware.
+	    \param p_micros Number of microseconds to advance the clock.*/
+	void advanceMicros(uint32_t p_micros);
+
+	/*! \brief Drives an input pin from outside the chip.
+	    \param p_pin Hardware pin to drive.
+	    \param p_high Level to drive the pin to.
+	    \note Triggers pin change and external interrupts if they are enabled.*/
+	void setPin(uint8_t p_pin, bool p_high);
+
+	/*! \brief Gets the current level of a pin.
+	    \param p_pin Hardware pin to read.
+	    \return Whether the pin is high.*/
+	bool getPin(uint8_t p_pin);
+
+	/*! \brief Connects an output pin to an input pin, the input follows the output without delay.
+	    \param p_from Hardware pin driving the wire.
+	    \param p_to Hardware pin being driven.
+	    \note Use this for loopback tests, like PPMOut into PPMIn.*/
+	void connect(uint8_t p_from, uint8_t p_to);
+	
+	/*! \brief Sets the value analogRead and conversions of the ADC will return.
+	    \param p_pin Analog pin, [A0 - A5] or [0 - 5].
+	    \param p_value Raw value, range [0 - 1023].*/
+	void setAnalog(uint8_t p_pin, uint16_t p_value);
+
+	/*! \brief Processes pending pin writes and interrupts.
+	    \note Only needed after writing port registers from outside an interrupt routine.*/
+	void sync();
+
+	/*! \brief Gets the number of logged edges.
+	    \return Number of edges in the log.*/
+	uint16_t getEdgeCount();
+
+	/*! \brief Gets a logged edge.
+	    \param p_index Index in the edge log, [0 - getEdgeCount()).
+	    \return The logged edge.*/
+	const Edge& getEdge(uint16_t p_index);
+
+	/*! \brief Clears the edge log.*/
+	void clearEdges();
+	
+	/*! \brief Lets the UART receive a byte.
+	    \param p_byte Byte to receive.
+	    \param p_error Whether the byte had a framing error.
+	    \note Ignored if the receiver isn't enabled, a byte which hasn't been read yet is overrun.*/
+	void uartReceive(uint8_t p_byte, bool p_error = false);
+	
+	/*! \brief Connects the UART transmitter to its receiver.
+	    \param p_loopback Whether every byte sent is received as well.*/
+	void setUartLoopback(bool p_loopback);
+	
+	/*! \brief Gets the number of logged UART bytes.
+	    \return Number of bytes in the UART log.*/
+	uint16_t getUartByteCount();
+	
+	/*! \brief Gets a byte sent by the UART.
+	    \param p_index Index in the UART log, [0 - getUartByteCount()).
+	    \return The logged byte.*/
+	const UartByte& getUartByte(uint16_t p_index);
+	
+	/*! \brief Clears the UART log.*/
+	void clearUartBytes();
+
+} // host
+} // rc
+
+#endif // INC_RC_HOST_H
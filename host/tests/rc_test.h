@@ -0,0 +1,78 @@
+#ifndef INC_RC_TEST_H
+#define INC_RC_TEST_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_test.h
+** Minimal checking macros and edge log helpers for the host tests
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include <rc_host.h>
+
+
+static int g_failures = 0;
+
+#define RC_TEST_CHECK(x) \
+	do { if (!(x)) { fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #x); ++g_failures; } } while (0)
+
+#define RC_TEST_EQUAL(a, b) \
+	do { long a_ = static_cast<long>(a); long b_ = static_cast<long>(b); if (a_ != b_) { \
+	fprintf(stderr, "%s:%d: check failed: %s (%ld) == %s (%ld)\n", __FILE__, __LINE__, #a, a_, #b, b_); \
+	++g_failures; } } while (0)
+
+#define RC_TEST_NEAR(a, b, tolerance) \
+	do { long a_ = static_cast<long>(a); long b_ = static_cast<long>(b); \
+	if (a_ - b_ > (tolerance) || b_ - a_ > (tolerance)) { \
+	fprintf(stderr, "%s:%d: check failed: %s (%ld) == %s (%ld) +/- %d\n", __FILE__, __LINE__, #a, a_, #b, b_, (tolerance)); \
+	++g_failures; } } while (0)
+
+#define RC_TEST_RESULT() \
+	(g_failures == 0 ? (printf("passed\n"), 0) : (printf("%d checks failed\n", g_failures), 1))
+
+
+// Cycle of the first edge of a pin at or after p_from, 0 if there is none
+static inline uint32_t findEdge(uint8_t p_pin, bool p_high, uint32_t p_from)
+{
+	for (uint16_t i = 0; i < rc::host::getEdgeCount(); ++i)
+	{
+		const rc::host::Edge& edge = rc::host::getEdge(i);
+		if (edge.pin == p_pin && edge.high == p_high && edge.cycle >= p_from)
+		{
+			return edge.cycle;
+		}
+	}
+	return 0;
+}
+
+
+// Length of the first pulse of a pin starting at or after p_from in cycles
+static inline uint32_t pulseCycles(uint8_t p_pin, uint32_t p_from)
+{
+	uint32_t rise = findEdge(p_pin, true, p_from);
+	return findEdge(p_pin, false, rise) - rise;
+}
+
+
+// Length of the first pulse of a pin starting at or after p_from in microseconds
+static inline uint32_t pulseLength(uint8_t p_pin, uint32_t p_from)
+{
+	return pulseCycles(p_pin, p_from) / (F_CPU / 1000000);
+}
+
+
+// Length of the first pulse of a pin starting at or after p_from in Timer1 ticks, prescaler 8
+static inline uint32_t pulseTicks(uint8_t p_pin, uint32_t p_from)
+{
+	return pulseCycles(p_pin, p_from) / (F_CPU / 2000000);
+}
+
+#endif // INC_RC_TEST_H
@@ -0,0 +1,131 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_adc.cpp
+** Free running ADC sampler and AIPin reading from it
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <AIPin.h>
+#include <rc_adc.h>
+#include <rc_host.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	Pins = 4,
+	
+	// the first conversion takes 25 ADC clocks, the others 13, the ADC clock is F_CPU / 128
+	FirstMicros      = 200,
+	ConversionMicros = 104,
+	
+	// 16 conversions per value, plus one thrown away after switching channels
+	RoundMicros = FirstMicros + 16 * ConversionMicros + (Pins - 1) * 17 * ConversionMicros
+};
+
+static const uint8_t  s_pins[Pins]   = { A0, A1, A2, A3 };
+static const uint16_t s_values[Pins] = { 100, 1023, 0, 700 };
+
+
+int main()
+{
+	rc::host::reset();
+	
+	rc::AIPin pins[Pins] =
+	{
+		rc::AIPin(A0),
+		rc::AIPin(A1),
+		rc::AIPin(A2),
+		rc::AIPin(A3)
+	};
+	int16_t expected[Pins];
+	for (uint8_t i = 0; i < Pins; ++i)
+	{
+		RC_TEST_CHECK(rc::adc::isEnabled(s_pins[i]));
+		rc::host::setAnalog(s_pins[i], s_values[i]);
+		pins[i].setCalibration(50, 500, 1000);
+		
+		// not started yet, AIPin uses analogRead
+		expected[i] = pins[i].read();
+	}
+	RC_TEST_CHECK(rc::adc::isEnabled(A4) == false);
+	RC_TEST_CHECK(rc::adc::isRunning() == false);
+	
+	// right after start the last value is held instead of reading 0, full deflection
+	pins[0].setDestination(rc::Input_THR);
+	RC_TEST_EQUAL(pins[0].read(), expected[0]);
+	rc::adc::start();
+	RC_TEST_CHECK(rc::adc::isRunning());
+	RC_TEST_CHECK(rc::adc::isReady(A0) == false);
+	RC_TEST_EQUAL(pins[0].read(), expected[0]);
+	RC_TEST_EQUAL(pins[2].read(), 0);
+	rc::host::advanceMicros(FirstMicros + 16 * ConversionMicros + 10);
+	RC_TEST_CHECK(rc::adc::isReady(A0));
+	RC_TEST_CHECK(rc::adc::isReady(A1) == false);
+	RC_TEST_EQUAL(pins[0].read(), expected[0]);
+	RC_TEST_EQUAL(pins[2].read(), 0);
+	
+	// all pins are converted in one round
+	rc::host::advanceMicros(RoundMicros - 10 - (FirstMicros + 16 * ConversionMicros + 10));
+	RC_TEST_CHECK(rc::adc::isReady() == false);
+	rc::host::advanceMicros(20);
+	RC_TEST_CHECK(rc::adc::isReady());
+	
+	// 16 samples, decimated to 12 bits, without channels mixing
+	for (uint8_t i = 0; i < Pins; ++i)
+	{
+		RC_TEST_EQUAL(rc::adc::read(s_pins[i]), s_values[i] << 2);
+		RC_TEST_EQUAL(pins[i].read(), expected[i]);
+	}
+	
+	// a changed input shows within a round
+	rc::host::setAnalog(A3, 701);
+	rc::host::advanceMicros(RoundMicros);
+	RC_TEST_EQUAL(rc::adc::read(A3), 701 << 2);
+	
+	// a single channel isn't switched, so no conversions are thrown away
+	rc::adc::disable(A1);
+	rc::adc::disable(A2);
+	rc::adc::disable(A3);
+	rc::host::advanceMicros(RoundMicros);
+	rc::host::setAnalog(A0, 300);
+	rc::host::advanceMicros(16 * ConversionMicros * 2);
+	RC_TEST_EQUAL(rc::adc::read(A0), 1200);
+	
+	// the sampler stops itself without channels and starts again with one
+	rc::adc::disable(A0);
+	rc::host::advanceMicros(RoundMicros);
+	RC_TEST_CHECK((ADCSRA & _BV(ADIE)) == 0);
+	rc::host::setAnalog(A2, 333);
+	rc::adc::enable(A2);
+	rc::host::advanceMicros(17 * ConversionMicros + 10);
+	RC_TEST_CHECK(rc::adc::isReady());
+	RC_TEST_EQUAL(rc::adc::read(A2), 333 << 2);
+	
+	// a channel disabled halfway its round isn't published
+	rc::host::setAnalog(A3, 555);
+	rc::adc::enable(A3);
+	rc::host::advanceMicros(16 * ConversionMicros + 5 * ConversionMicros);
+	rc::adc::disable(A3);
+	rc::host::advanceMicros(17 * ConversionMicros);
+	RC_TEST_CHECK(rc::adc::isReady(A3) == false);
+	RC_TEST_EQUAL(rc::adc::read(A3), 701 << 2);
+	RC_TEST_CHECK(rc::adc::isReady());
+	
+	// stopped, AIPin uses analogRead again
+	rc::adc::stop();
+	RC_TEST_CHECK(rc::adc::isRunning() == false);
+	rc::host::setAnalog(A0, 800);
+	RC_TEST_EQUAL(pins[0].read(), 153);
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,210 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_crsf.cpp
+** CRSFOut packets, CRC and packet rate, through a UART loopback
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <CRSFOut.h>
+#include <outputchannel.h>
+#include <rc_host.h>
+#include <rc_uartint.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	PacketSize = 26,
+	ByteTime   = 25 // 10 bits at 400000 baud
+};
+
+// all channels at 1500 us
+static const uint8_t s_center[PacketSize] =
+{
+	0xEE, 0x18, 0x16, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F,
+	0x7C, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0xAD
+};
+
+static const uint16_t s_variedMicros[16] =
+{
+	988, 2012, 1500, 1000, 2000, 1200, 1800, 880, 2159, 1520, 1100, 1900, 1300, 1700, 1400, 1600
+};
+
+// 173, 1812, 992, 192, 1792, 512, 1472, 0, 2047, 1024, 352, 1632, 672, 1312, 832, 1152
+static const uint8_t s_varied[PacketSize] =
+{
+	0xEE, 0x18, 0x16, 0xAD, 0xA0, 0x38, 0xF8, 0x80, 0x01, 0x70, 0x00, 0x01, 0x17,
+	0x00, 0xFF, 0x07, 0x20, 0x58, 0xC0, 0x0C, 0x2A, 0x90, 0x02, 0x0D, 0x90, 0x3A
+};
+
+static uint8_t  s_received[PacketSize * 4];
+static uint16_t s_receivedCount = 0;
+static uint32_t s_starts[200]; // time at which packets were started in microseconds
+
+
+static void received(uint8_t p_byte, bool p_valid, void* p_user)
+{
+	RC_TEST_CHECK(p_valid);
+	if (s_receivedCount < sizeof(s_received))
+	{
+		s_received[s_receivedCount] = p_byte;
+	}
+	++s_receivedCount;
+}
+
+
+// Bit by bit CRC8 with polynomial 0xD5, to check the table against
+static uint8_t referenceCrc(const uint8_t* p_data, uint8_t p_length)
+{
+	uint8_t crc = 0;
+	for (uint8_t i = 0; i < p_length; ++i)
+	{
+		crc ^= p_data[i];
+		for (uint8_t bit = 0; bit < 8; ++bit)
+		{
+			crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0xD5) : static_cast<uint8_t>(crc << 1);
+		}
+	}
+	return crc;
+}
+
+
+static void setOutputChannels(const uint16_t* p_values)
+{
+	for (uint8_t i = 0; i < 16 && i < RC_MAX_CHANNELS; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), p_values[i]);
+	}
+}
+
+
+// Sends one packet and checks what came back through the loopback, byte for byte
+static void checkPacket(rc::CRSFOut& p_out, const uint8_t* p_expected)
+{
+	s_receivedCount = 0;
+	rc::host::clearUartBytes();
+	rc::host::advanceMicros(1000000UL / p_out.getRate());
+	RC_TEST_CHECK(p_out.update());
+	rc::host::advanceMicros(PacketSize * ByteTime + 10);
+	
+	RC_TEST_EQUAL(s_receivedCount, PacketSize);
+	RC_TEST_EQUAL(rc::host::getUartByteCount(), PacketSize);
+	for (uint8_t i = 0; i < PacketSize; ++i)
+	{
+		RC_TEST_EQUAL(s_received[i], p_expected[i]);
+	}
+	for (uint8_t i = 1; i < PacketSize; ++i)
+	{
+		RC_TEST_EQUAL(rc::host::getUartByte(i).cycle - rc::host::getUartByte(i - 1).cycle, ByteTime * 16);
+	}
+	RC_TEST_EQUAL(rc::CRSFOut::crc8(s_received + 2, PacketSize - 3), s_received[PacketSize - 1]);
+}
+
+
+// Polls update() every p_poll microseconds, returns the number of packets started
+static uint16_t run(rc::CRSFOut& p_out, uint32_t p_micros, uint16_t p_poll)
+{
+	uint16_t packets = 0;
+	for (uint32_t t = 0; t < p_micros; t += p_poll)
+	{
+		if (p_out.update())
+		{
+			if (packets < sizeof(s_starts) / sizeof(s_starts[0]))
+			{
+				s_starts[packets] = micros();
+			}
+			++packets;
+		}
+		rc::host::advanceMicros(p_poll);
+	}
+	return packets;
+}
+
+
+int main()
+{
+	// table driven CRC against the bit by bit one
+	{
+		uint8_t  data[64];
+		uint32_t seed = 12345;
+		for (uint8_t round = 0; round < 100; ++round)
+		{
+			for (uint8_t i = 0; i < sizeof(data); ++i)
+			{
+				seed = seed * 1103515245UL + 12345;
+				data[i] = static_cast<uint8_t>(seed >> 16);
+			}
+			uint8_t length = round % sizeof(data);
+			RC_TEST_EQUAL(rc::CRSFOut::crc8(data, length), referenceCrc(data, length));
+		}
+		RC_TEST_EQUAL(rc::CRSFOut::crc8(s_center + 2, PacketSize - 3), 0xAD);
+	}
+	
+	rc::host::reset();
+	rc::host::setUartLoopback(true);
+	rc::uartint::setRxHandler(received);
+	UCSR0B |= _BV(RXEN0) | _BV(RXCIE0);
+	
+	rc::CRSFOut out;
+	out.start();
+	
+	// packets byte for byte
+	for (uint8_t i = 0; i < 16 && i < RC_MAX_CHANNELS; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), 1500);
+	}
+	checkPacket(out, s_center);
+	setOutputChannels(s_variedMicros);
+	checkPacket(out, s_varied);
+	
+	// 500 Hz, a packet every 2 ms
+	out.setRate(500);
+	run(out, 10000, 50);
+	RC_TEST_EQUAL(run(out, 100000, 50), 50);
+	for (uint8_t p = 1; p < 50; ++p)
+	{
+		RC_TEST_EQUAL(s_starts[p] - s_starts[p - 1], 2000);
+	}
+	
+	// 150 Hz doesn't fit whole microseconds, polling at 100 us the packets are
+	// at most one poll late and don't drift
+	out.setRate(150);
+	run(out, 20000, 100);
+	RC_TEST_NEAR(run(out, 1000000, 100), 150, 1);
+	for (uint8_t p = 1; p < 149; ++p)
+	{
+		RC_TEST_NEAR(s_starts[p] - s_starts[p - 1], 6666, 100);
+	}
+	RC_TEST_NEAR(s_starts[148] - s_starts[0], 148UL * 1000000 / 150, 100);
+	
+	// a late update delays one packet, the next one is back on schedule
+	out.setRate(250);
+	run(out, 10000, 50);
+	uint32_t due = s_starts[run(out, 4000, 50) - 1] + 4000;
+	rc::host::advanceMicros(due - micros() + 1000);
+	RC_TEST_EQUAL(run(out, 4000, 50), 2);
+	RC_TEST_EQUAL(s_starts[0], due + 1000);
+	RC_TEST_EQUAL(s_starts[1], due + 4000);
+	
+	// missing more than a whole packet starts a new schedule instead of sending a burst
+	rc::host::advanceMicros(20000);
+	RC_TEST_EQUAL(run(out, 4000, 50), 1);
+	RC_TEST_EQUAL(run(out, 4000, 50), 1);
+	
+	out.stop();
+	rc::host::advanceMicros(1000);
+	rc::host::clearUartBytes();
+	RC_TEST_EQUAL(run(out, 10000, 50), 0);
+	RC_TEST_EQUAL(rc::host::getUartByteCount(), 0);
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,123 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_expo.cpp
+** Expo response table, FixedExpo and FixedDualRates against Expo and DualRates
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <DualRates.h>
+#include <Expo.h>
+#include <FixedDualRates.h>
+#include <FixedExpo.h>
+#include <input.h>
+
+#include "rc_test.h"
+
+
+// The response table should give exactly the same results for all expo values
+static void checkTable()
+{
+	uint8_t table[rc::Expo::TableSize];
+	rc::Expo calculated;
+	rc::Expo tabled;
+	tabled.setTable(table);
+	for (int8_t e = -100; e <= 100; ++e)
+	{
+		calculated = e;
+		tabled.set(e);
+		for (int16_t v = -256; v <= 256; ++v)
+		{
+			RC_TEST_EQUAL(tabled.apply(v), calculated.apply(v));
+		}
+	}
+	
+	// modifying the expo through a pointer bypasses the table
+	*(&tabled) = 40;
+	calculated = 40;
+	RC_TEST_EQUAL(tabled.apply(100), calculated.apply(100));
+	
+	// copy assignment rebuilds the table
+	rc::Expo copy(-60);
+	tabled = copy;
+	RC_TEST_EQUAL(table[100], -copy.apply(-100));
+	
+	// a copy constructed object calculates, it doesn't share the table of the original
+	rc::Expo constructed(tabled);
+	RC_TEST_EQUAL(constructed.get(), -60);
+	tabled.set(80);
+	RC_TEST_EQUAL(constructed.apply(100), copy.apply(100));
+	constructed.set(20);
+	RC_TEST_EQUAL(tabled.apply(100), rc::Expo(80).apply(100));
+}
+
+
+// FixedExpo rounds the blended curve differently, so it may be off by one
+template<int8_t E>
+static void checkExpo()
+{
+	rc::Expo expo(E);
+	rc::FixedExpo<E> fixed;
+	for (int16_t v = -256; v <= 256; ++v)
+	{
+		RC_TEST_NEAR(fixed.apply(v), expo.apply(v), 1);
+	}
+	RC_TEST_EQUAL(fixed.apply(-256), -256);
+	RC_TEST_EQUAL(fixed.apply(0), 0);
+	RC_TEST_EQUAL(fixed.apply(256), 256);
+}
+
+
+// FixedDualRates should give exactly the same results
+template<uint8_t R>
+static void checkRates()
+{
+	rc::DualRates rates(R);
+	rc::FixedDualRates<R> fixed;
+	for (int16_t v = -256; v <= 256; ++v)
+	{
+		RC_TEST_EQUAL(fixed.apply(v), rates.apply(v));
+	}
+}
+
+
+int main()
+{
+	checkTable();
+	
+	checkExpo<-100>();
+	checkExpo<-30>();
+	checkExpo<-10>();
+	checkExpo<0>();
+	checkExpo<20>();
+	checkExpo<50>();
+	checkExpo<100>();
+	
+	checkRates<0>();
+	checkRates<1>();
+	checkRates<33>();
+	checkRates<80>();
+	checkRates<99>();
+	checkRates<100>();
+	checkRates<101>();
+	checkRates<140>();
+	
+	// input system
+	rc::FixedExpo<-30> expo(rc::Input_AIL);
+	rc::FixedDualRates<80> rates(rc::Input_AIL);
+	rc::setInput(rc::Input_AIL, 200);
+	expo.apply();
+	RC_TEST_NEAR(rc::getInput(rc::Input_AIL), rc::Expo(-30).apply(200), 1);
+	rc::setInput(rc::Input_AIL, 200);
+	rates.apply();
+	RC_TEST_EQUAL(rc::getInput(rc::Input_AIL), 160);
+	
+	return RC_TEST_RESULT();
+}
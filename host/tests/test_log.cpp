@@ -0,0 +1,243 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_log.cpp
+** Deferred binary logging, records in the log buffer
+** Run with a log file and an expected output file as arguments to write records
+** for test_logdecode.py.
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#define RC_DEBUG_LEVEL 5
+#define RC_BINARY_LOG
+
+#include <stdarg.h>
+#include <string.h>
+
+#include <Arduino.h>
+
+#include <rc_host.h>
+#include <rc_debug.h>
+#include <rc_uart.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	PointerSize = sizeof(const char*),
+	HeaderSize  = 5 + 2 * PointerSize,
+	ByteCycles  = 10 * 8 * 17 // 115200 baud at double speed, UBRR 16
+};
+
+
+static FILE* s_log      = 0;
+static FILE* s_expected = 0;
+
+
+static const char* pointerAt(const uint8_t* p_data)
+{
+	const char* pointer;
+	memcpy(&pointer, p_data, sizeof(pointer));
+	return pointer;
+}
+
+
+// Moves the log buffer to the log file and writes what the decoder should make of the record
+static void expect(const char* p_level, const char* p_file, int p_line, const char* p_fmt, ...)
+{
+	uint8_t data[RC_LOG_SIZE];
+	uint8_t count = rc::log::read(data, sizeof(data));
+	RC_TEST_CHECK(count >= HeaderSize);
+	fwrite(data, 1, count, s_log);
+	
+	fprintf(s_expected, "[%s] %s:%d: ", p_level, p_file, p_line);
+	va_list vlist;
+	va_start(vlist, p_fmt);
+	vfprintf_P(s_expected, p_fmt, vlist);
+	va_end(vlist);
+	fprintf(s_expected, "\n");
+}
+
+#define EXPECT(level, fmt, ...) \
+	do { RC_##level(fmt, ##__VA_ARGS__); expect(#level, __FILE__, __LINE__, fmt, ##__VA_ARGS__); } while (0)
+
+
+static void writeDecoderInput(const char* p_log, const char* p_expected)
+{
+	s_log = fopen(p_log, "wb");
+	s_expected = fopen(p_expected, "w");
+	RC_TEST_CHECK(s_log != 0 && s_expected != 0);
+	if (s_log == 0 || s_expected == 0)
+	{
+		return;
+	}
+	
+	rc::log::clear();
+	EXPECT(TRACE, "no arguments");
+	EXPECT(DEBUG, "This is a debug message with %d %s", 2, "parameters");
+	EXPECT(INFO, "unsigned %u hex %04x char %c", 40000u, 0xBEEF, 'x');
+	EXPECT(WARN, "long %ld, %lu", -100000L, 3000000000UL);
+	EXPECT(ERROR, "float %.2f, progmem %S, percent %%", 1.5f, PSTR("flash"));
+	EXPECT(DEBUG, "width %*d|%-5d|", 6, -42, 7);
+	
+	uint8_t small = 200;
+	int8_t negative = -5;
+	bool flag = true;
+	EXPECT(DEBUG, "promoted %d %d %d", small, negative, flag);
+	
+	RC_CHECK(g_failures < 0); expect("WARN", __FILE__, __LINE__, "failed check: %S", "g_failures < 0");
+	
+	fclose(s_log);
+	fclose(s_expected);
+}
+
+
+int main(int p_argc, char** p_argv)
+{
+	rc::host::reset();
+	rc::log::clear();
+	RC_TEST_EQUAL(rc::log::available(), 0);
+	
+	// a record holds the level, line, file, format and raw arguments
+	{
+		RC_DEBUG("value %d", 42); int line = __LINE__;
+		RC_TEST_EQUAL(rc::log::available(), HeaderSize + sizeof(int));
+		
+		uint8_t data[RC_LOG_SIZE];
+		RC_TEST_EQUAL(rc::log::read(data, sizeof(data)), HeaderSize + sizeof(int));
+		RC_TEST_EQUAL(data[0], rc::log::Sync);
+		RC_TEST_EQUAL(data[1], rc::log::Level_Debug);
+		RC_TEST_EQUAL(data[2], sizeof(int));
+		RC_TEST_EQUAL(data[3] | (data[4] << 8), line);
+		RC_TEST_CHECK(strcmp(pointerAt(data + 5), __FILE__) == 0);
+		RC_TEST_CHECK(strcmp(pointerAt(data + 5 + PointerSize), "value %d") == 0);
+		int value;
+		memcpy(&value, data + HeaderSize, sizeof(value));
+		RC_TEST_EQUAL(value, 42);
+		RC_TEST_EQUAL(rc::log::available(), 0);
+	}
+	
+	// arguments are promoted like printf arguments
+	{
+		uint8_t small = 200;
+		char c = 'a';
+		int32_t large = -70000;
+		RC_TRACE("%d %c %ld %S", small, c, large, PSTR("text"));
+		uint8_t data[RC_LOG_SIZE];
+		RC_TEST_EQUAL(rc::log::read(data, sizeof(data)), HeaderSize + 2 * sizeof(int) + sizeof(int32_t) + PointerSize);
+		RC_TEST_EQUAL(data[1], rc::log::Level_Trace);
+		RC_TEST_EQUAL(data[2], 2 * sizeof(int) + sizeof(int32_t) + PointerSize);
+		int value;
+		memcpy(&value, data + HeaderSize, sizeof(value));
+		RC_TEST_EQUAL(value, 200);
+		memcpy(&value, data + HeaderSize + sizeof(int), sizeof(value));
+		RC_TEST_EQUAL(value, 'a');
+		memcpy(&large, data + HeaderSize + 2 * sizeof(int), sizeof(large));
+		RC_TEST_EQUAL(large, -70000);
+		RC_TEST_CHECK(strcmp(pointerAt(data + HeaderSize + 2 * sizeof(int) + sizeof(int32_t)), "text") == 0);
+	}
+	
+	// records that don't fit are dropped as a whole and counted
+	{
+		uint8_t records = 0;
+		while (rc::log::getDropped() == 0)
+		{
+			RC_INFO("filling %d", records);
+			++records;
+		}
+		RC_INFO("filling %d", records);
+		uint8_t fit = (RC_LOG_SIZE - 1) / (HeaderSize + sizeof(int));
+		RC_TEST_EQUAL(records, fit + 1);
+		RC_TEST_EQUAL(rc::log::getDropped(), 2);
+		RC_TEST_EQUAL(rc::log::available(), fit * (HeaderSize + sizeof(int)));
+		
+		// reading in small pieces gives the records back in order
+		for (uint8_t i = 0; i < fit; ++i)
+		{
+			uint8_t data[HeaderSize + sizeof(int)];
+			RC_TEST_EQUAL(rc::log::read(data, 3), 3);
+			RC_TEST_EQUAL(rc::log::read(data + 3, sizeof(data) - 3), sizeof(data) - 3);
+			RC_TEST_EQUAL(data[0], rc::log::Sync);
+			int value;
+			memcpy(&value, data + HeaderSize, sizeof(value));
+			RC_TEST_EQUAL(value, i);
+		}
+		RC_TEST_EQUAL(rc::log::available(), 0);
+		
+		rc::log::clear();
+		RC_TEST_EQUAL(rc::log::getDropped(), 0);
+	}
+	
+	// messages of modules that aren't in the mask are skipped
+	{
+		rc::setDebugMask(0xFF & ~(1 << RC_MODULE_USER));
+		RC_INFO("masked");
+		RC_CHECK(g_failures < 0);
+		RC_TEST_EQUAL(rc::log::available(), 0);
+		
+		rc::setDebugMask(1 << RC_MODULE_USER);
+		RC_INFO("enabled");
+		RC_TEST_EQUAL(rc::log::available(), HeaderSize);
+		rc::setDebugMask(0xFF);
+		rc::log::clear();
+	}
+	
+	// logging doesn't take any time on the simulated processor
+	{
+		uint32_t start = rc::host::getCycles();
+		RC_WARN("nothing to wait for");
+		RC_TEST_EQUAL(rc::host::getCycles(), start);
+		rc::log::clear();
+	}
+	
+	// send moves the buffer to the uart, as much as fits
+	{
+		rc::uart::init(115200);
+		rc::host::clearUartBytes();
+		
+		// the same records twice, the first time to see what they look like
+		uint8_t first[RC_LOG_SIZE];
+		uint8_t size = 0;
+		for (uint8_t round = 0; round < 2; ++round)
+		{
+			for (uint8_t i = 0; i < 3; ++i)
+			{
+				RC_ERROR("record %d of %d", i, 3);
+			}
+			if (round == 0)
+			{
+				size = rc::log::read(first, sizeof(first));
+			}
+		}
+		RC_TEST_EQUAL(rc::log::available(), size);
+		
+		rc::log::send();
+		RC_TEST_EQUAL(rc::log::available(), size > RC_UART_TX_SIZE - 1 ? size - (RC_UART_TX_SIZE - 1) : 0);
+		RC_TEST_EQUAL(rc::uart::getTxOverflows(), 0);
+		while (rc::log::available() > 0)
+		{
+			rc::host::advance(ByteCycles * 8UL);
+			rc::log::send();
+		}
+		RC_TEST_EQUAL(rc::uart::getTxOverflows(), 0);
+		rc::host::advance(ByteCycles * static_cast<uint32_t>(RC_UART_TX_SIZE + 1));
+		RC_TEST_EQUAL(rc::host::getUartByteCount(), size);
+		for (uint8_t i = 0; i < size && i < rc::host::getUartByteCount(); ++i)
+		{
+			RC_TEST_EQUAL(rc::host::getUartByte(i).data, first[i]);
+		}
+	}
+	
+	if (p_argc == 3)
+	{
+		writeDecoderInput(p_argv[1], p_argv[2]);
+	}
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+# ---------------------------------------------------------------------------
+# This software is in the public domain, furnished "as is", without technical
+# support, and with no warranty, express or implied, as to its usefulness for
+# any purpose.
+#
+# test_logdecode.py
+# Decodes the records written by test_log and compares them to printf's output
+#
+# Usage: test_logdecode.py <test_log executable> <rc_logdecode.py>
+#
+# Author: Daniel van den Ouden
+# Project: ArduinoRCLib
+# Website: http://sourceforge.net/p/arduinorclib/
+# ---------------------------------------------------------------------------
+
+import os
+import subprocess
+import sys
+import tempfile
+
+
+def decode(decoder, elf, data):
+	result = subprocess.run([sys.executable, decoder, elf], input=data, stdout=subprocess.PIPE, check=True)
+	return result.stdout.decode().splitlines()
+
+
+def main(test_log, decoder):
+	with tempfile.TemporaryDirectory() as folder:
+		log = os.path.join(folder, 'log.bin')
+		expected = os.path.join(folder, 'expected.txt')
+		subprocess.run([test_log, log, expected], stdout=subprocess.DEVNULL, check=True)
+		with open(log, 'rb') as f:
+			data = f.read()
+		with open(expected) as f:
+			lines = f.read().splitlines()
+
+	failures = 0
+	cases = [
+		('log', data),
+		# noise before and in between records is skipped, including stray sync bytes
+		('noise', b'\x00\xa5\x01\x07' + data[:len(data) // 2] + b'\xa5\xa5' + data[len(data) // 2:]),
+		# a cut off record at the end is not printed
+		('cut off', data + data[:7]),
+	]
+	for name, stream in cases:
+		decoded = decode(decoder, test_log, stream)
+		if name == 'noise':
+			# the record the noise was put in is lost
+			decoded = [line for line in decoded if line in lines]
+			missing = len(lines) - len(decoded)
+			if missing > 1:
+				print('%s: %d records lost' % (name, missing))
+				failures += 1
+			lines_expected = [line for line in lines if line in decoded]
+		else:
+			lines_expected = lines
+		if decoded != lines_expected:
+			failures += 1
+			print('%s: decoded output differs' % name)
+			for a, b in zip(decoded, lines_expected):
+				if a != b:
+					print('  got      %s\n  expected %s' % (a, b))
+			if len(decoded) != len(lines_expected):
+				print('  got %d lines, expected %d' % (len(decoded), len(lines_expected)))
+
+	if len(lines) < 8:
+		failures += 1
+		print('only %d records written' % len(lines))
+
+	if failures == 0:
+		print('passed')
+		return 0
+	print('%d checks failed' % failures)
+	return 1
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv[1], sys.argv[2]))
@@ -0,0 +1,353 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_ppm.cpp
+** PPMOut signal timing and PPMOut to PPMIn loopback, with pin change interrupts and input capture
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <inputchannel.h>
+#include <outputchannel.h>
+#include <PPMIn.h>
+#include <PPMOut.h>
+#include <rc_host.h>
+#include <Timer1.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	Channels    = 8,
+	FrameLength = 17270 // sum of s_values + pause
+};
+
+static const uint16_t s_values[Channels] = { 1000, 1100, 1250, 1500, 1520, 1750, 1900, 2000 };
+static const uint16_t s_update[Channels] = { 2000, 1900, 1750, 1520, 1500, 1250, 1100, 1000 };
+
+
+// Checks the distance between rising edges on p_pin against the channel values
+static void checkTimings(uint8_t p_pin, const uint16_t* p_values = s_values)
+{
+	// find the start of a frame, the rising edge after the pause
+	uint32_t last = 0;
+	uint16_t idx = 0;
+	bool found = false;
+	for (; idx < rc::host::getEdgeCount(); ++idx)
+	{
+		const rc::host::Edge& edge = rc::host::getEdge(idx);
+		if (edge.pin == p_pin && edge.high)
+		{
+			if (last != 0 && edge.cycle - last > 5000 * 16)
+			{
+				found = true;
+				last = edge.cycle;
+				++idx;
+				break;
+			}
+			last = edge.cycle;
+		}
+	}
+	RC_TEST_CHECK(found);
+
+	uint8_t channel = 0;
+	for (; idx < rc::host::getEdgeCount() && channel < Channels; ++idx)
+	{
+		const rc::host::Edge& edge = rc::host::getEdge(idx);
+		if (edge.pin == p_pin && edge.high)
+		{
+			RC_TEST_EQUAL((edge.cycle - last) / 16, p_values[channel]);
+			last = edge.cycle;
+			++channel;
+		}
+	}
+	RC_TEST_EQUAL(channel, Channels);
+}
+
+
+// Counts the edges on p_pin which end a pause of at least p_pause microseconds, from p_first on
+static uint16_t countFrameEnds(uint8_t p_pin, bool p_high, uint16_t p_pause, uint16_t p_first)
+{
+	uint32_t last = 0;
+	uint16_t count = 0;
+	for (uint16_t idx = 0; idx < rc::host::getEdgeCount(); ++idx)
+	{
+		const rc::host::Edge& edge = rc::host::getEdge(idx);
+		if (edge.pin == p_pin && edge.high == p_high)
+		{
+			if (idx >= p_first && last != 0 && edge.cycle - last >= p_pause * 16UL)
+			{
+				++count;
+			}
+			last = edge.cycle;
+		}
+	}
+	return count;
+}
+
+
+// PPMOut to PPMIn loopback, PPMIn on p_pin
+static void checkLoopback(uint8_t p_pin)
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	rc::host::connect(9, p_pin);
+
+	rc::PPMIn in;
+	in.setPin(p_pin);
+	in.setPauseLength(3000);
+	in.start();
+
+	rc::PPMOut out(Channels);
+	out.start(9);
+
+	for (uint8_t frame = 0; frame < 5; ++frame)
+	{
+		rc::host::advanceMicros(22000);
+		in.update();
+	}
+	RC_TEST_CHECK(in.isStable());
+	RC_TEST_EQUAL(in.getChannels(), Channels);
+	for (uint8_t i = 0; i < Channels; ++i)
+	{
+		RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), s_values[i]);
+	}
+	
+	// the statistics of a clean signal
+	rc::InputStats stats;
+	in.getStats(stats);
+	RC_TEST_EQUAL(stats.frames, countFrameEnds(p_pin, false, 3000, 0) - 1); // the first one syncs
+	RC_TEST_EQUAL(stats.confused, 0);
+	RC_TEST_EQUAL(stats.timeouts, 0);
+	RC_TEST_EQUAL(stats.channelChanges, 0);
+	RC_TEST_NEAR(stats.maxGap, FrameLength, 8);
+	
+	// a slow update gets the newest queued frame and counts the frames in between as dropped
+	for (uint8_t skip = 1; skip < 4; ++skip)
+	{
+		uint16_t dropped = in.getDroppedFrames();
+		uint16_t first = rc::host::getEdgeCount();
+		rc::host::advanceMicros(skip * FrameLength - 1000);
+		RC_TEST_EQUAL(countFrameEnds(p_pin, false, 3000, first), skip);
+		RC_TEST_CHECK(in.update());
+		RC_TEST_EQUAL(in.getDroppedFrames() - dropped, skip - 1);
+		RC_TEST_CHECK(in.update() == false);
+		rc::host::advanceMicros(1000);
+	}
+	
+	// when the queue is full new frames are dropped, they're counted
+	// as soon as update() gets a frame received after them
+	uint16_t dropped = in.getDroppedFrames();
+	uint16_t first = rc::host::getEdgeCount();
+	uint16_t delivered = 0;
+	for (uint8_t skip = 1; skip < 12; ++skip)
+	{
+		rc::host::advanceMicros(skip * FrameLength);
+		RC_TEST_CHECK(in.update());
+		RC_TEST_CHECK(in.update() == false);
+		++delivered;
+	}
+	rc::host::advanceMicros(FrameLength);
+	RC_TEST_CHECK(in.update());
+	++delivered;
+	RC_TEST_EQUAL(in.getDroppedFrames() - dropped + delivered, countFrameEnds(p_pin, false, 3000, first));
+	
+	for (uint8_t i = 0; i < Channels; ++i)
+	{
+		RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), s_values[i]);
+	}
+
+	// pull the plug
+	out.stop();
+	rc::host::advanceMicros(1000000);
+	in.update();
+	RC_TEST_CHECK(in.isLost());
+	in.getStats(stats);
+	RC_TEST_EQUAL(stats.timeouts, 1);
+	RC_TEST_EQUAL(stats.confused, 0);
+	RC_TEST_NEAR(stats.maxGap, FrameLength, 8); // slow updates don't matter, the frames are timed when received
+	in.stop();
+}
+
+
+// A change in the number of channels confuses PPMIn until it has synced again
+static void checkStats(uint8_t p_pin)
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	rc::host::connect(9, p_pin);
+	
+	rc::PPMIn in;
+	in.setPin(p_pin);
+	in.setPauseLength(3000);
+	in.start();
+	
+	rc::PPMOut out(Channels);
+	out.start(9);
+	
+	for (uint8_t frame = 0; frame < 5; ++frame)
+	{
+		rc::host::advanceMicros(FrameLength);
+		in.update();
+	}
+	RC_TEST_CHECK(in.isStable());
+	
+	out.setChannelCount(Channels - 2);
+	out.update();
+	for (uint8_t frame = 0; frame < 10; ++frame)
+	{
+		rc::host::advanceMicros(FrameLength);
+		in.update();
+	}
+	RC_TEST_CHECK(in.isStable());
+	RC_TEST_EQUAL(in.getChannels(), Channels - 2);
+	
+	rc::InputStats stats;
+	in.getStats(stats);
+	RC_TEST_EQUAL(stats.confused, 1);
+	RC_TEST_EQUAL(stats.channelChanges, 1);
+	RC_TEST_EQUAL(stats.timeouts, 0);
+	RC_TEST_CHECK(stats.maxGap > FrameLength); // at least one frame is lost while syncing
+	RC_TEST_CHECK(stats.maxGap < 4 * FrameLength);
+	
+	in.resetStats();
+	in.getStats(stats);
+	RC_TEST_EQUAL(stats.frames, 0);
+	RC_TEST_EQUAL(stats.confused, 0);
+	RC_TEST_EQUAL(stats.channelChanges, 0);
+	RC_TEST_EQUAL(stats.maxGap, 0);
+	
+	out.stop();
+	in.stop();
+}
+
+
+// Edges arriving while interrupts are disabled, with input capture these should still be timed exactly
+static void checkLatency(uint8_t p_pin, bool p_exact)
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	rc::host::connect(9, p_pin);
+	
+	rc::PPMIn in;
+	in.setPin(p_pin);
+	in.setPauseLength(3000);
+	in.start();
+	
+	rc::PPMOut out(Channels);
+	out.start(9);
+	
+	for (uint8_t frame = 0; frame < 5; ++frame)
+	{
+		rc::host::advanceMicros(FrameLength);
+		in.update();
+	}
+	
+	// disable interrupts for 200 us at a different place in every frame,
+	// shorter than a pulse so PPMOut isn't affected
+	uint8_t wrong = 0;
+	for (uint8_t frame = 0; frame < 40; ++frame)
+	{
+		uint16_t offset = (frame * 1237UL) % (FrameLength - 200);
+		rc::host::advanceMicros(offset);
+		cli();
+		rc::host::advanceMicros(200);
+		sei();
+		rc::host::advanceMicros(FrameLength - 200 - offset);
+		RC_TEST_CHECK(in.update());
+		
+		for (uint8_t i = 0; i < Channels; ++i)
+		{
+			if (rc::getInputChannel(static_cast<rc::InputChannel>(i)) != s_values[i])
+			{
+				++wrong;
+				break;
+			}
+		}
+	}
+	RC_TEST_CHECK(in.isStable());
+	if (p_exact)
+	{
+		RC_TEST_EQUAL(wrong, 0);
+	}
+	else
+	{
+		RC_TEST_CHECK(wrong > 0);
+	}
+	
+	out.stop();
+	in.stop();
+}
+
+
+int main()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+
+	for (uint8_t i = 0; i < Channels; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), s_values[i]);
+	}
+
+	// hardware toggled pin
+	{
+		rc::PPMOut out(Channels);
+		out.start(9);
+		rc::host::advanceMicros(50000);
+		checkTimings(9);
+		
+		// new values are only sent after update, and then as a complete frame
+		for (uint8_t i = 0; i < Channels; ++i)
+		{
+			rc::setOutputChannel(static_cast<rc::OutputChannel>(i), s_update[i]);
+		}
+		rc::host::clearEdges();
+		rc::host::advanceMicros(50000);
+		checkTimings(9);
+		
+		out.update();
+		rc::host::advanceMicros(20000);
+		rc::host::clearEdges();
+		rc::host::advanceMicros(50000);
+		checkTimings(9, s_update);
+		
+		out.stop();
+		
+		for (uint8_t i = 0; i < Channels; ++i)
+		{
+			rc::setOutputChannel(static_cast<rc::OutputChannel>(i), s_values[i]);
+		}
+	}
+
+	// software toggled pin
+	{
+		rc::host::reset();
+		rc::Timer1::init();
+		rc::PPMOut out(Channels);
+		out.start(7);
+		rc::host::advanceMicros(50000);
+		checkTimings(7);
+		out.stop();
+	}
+
+	// loopback, pin 8 uses input capture, pin 7 pin change interrupts
+	checkLoopback(8);
+	checkLoopback(7);
+	
+	// statistics
+	checkStats(8);
+	
+	// interrupt latency only affects pin change interrupts
+	checkLatency(8, true);
+	checkLatency(7, false);
+	
+	return RC_TEST_RESULT();
+}
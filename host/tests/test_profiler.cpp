@@ -0,0 +1,113 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_profiler.cpp
+** Loop profiler, statistics and histograms of timed stages
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#define RC_USE_PROFILER
+
+#include <string.h>
+
+#include <Arduino.h>
+
+#include <rc_host.h>
+#include <rc_profiler.h>
+#include <Timer1.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	Stage_Busy,
+	Stage_Mixed,
+	Stage_Unused
+};
+
+
+int main()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	rc::Timer1::start();
+	rc::profiler::reset();
+	rc::profiler::setName(Stage_Busy, PSTR("busy"));
+	
+	// runs of 100 to 190 microseconds, timed in ticks of half a microsecond
+	for (uint8_t i = 0; i < 10; ++i)
+	{
+		RC_PROFILE(Stage_Busy);
+		rc::host::advanceMicros(100 + i * 10);
+	}
+	{
+		const rc::profiler::Stage& stage = rc::profiler::getStage(Stage_Busy);
+		RC_TEST_EQUAL(stage.count, 10);
+		RC_TEST_EQUAL(stage.min, 200);
+		RC_TEST_EQUAL(stage.max, 380);
+		RC_TEST_EQUAL(stage.total, 2900);
+		RC_TEST_EQUAL(stage.histogram[3], 3); // 64 - 128 us
+		RC_TEST_EQUAL(stage.histogram[4], 7); // 128 - 256 us
+		RC_TEST_CHECK(strcmp(stage.name, "busy") == 0);
+	}
+	
+	// the bins double in width, the last one takes everything longer, also runs over a Timer1 wrap
+	static const uint16_t s_runs[] = { 0, 15, 16, 31, 32, 1023, 1024, 30000 };
+	static const uint8_t  s_bins[] = { 0,  0,  1,  1,  2,    6,    7,     7 };
+	for (uint8_t i = 0; i < sizeof(s_runs) / sizeof(s_runs[0]); ++i)
+	{
+		uint16_t begin = rc::profiler::begin();
+		rc::host::advanceMicros(s_runs[i]);
+		rc::profiler::end(Stage_Mixed, begin);
+	}
+	{
+		const rc::profiler::Stage& stage = rc::profiler::getStage(Stage_Mixed);
+		RC_TEST_EQUAL(stage.count, 8);
+		RC_TEST_EQUAL(stage.min, 0);
+		RC_TEST_EQUAL(stage.max, 60000);
+		uint16_t expected[rc::profiler::Bins] = { 0 };
+		for (uint8_t i = 0; i < sizeof(s_bins); ++i)
+		{
+			++expected[s_bins[i]];
+		}
+		for (uint8_t bin = 0; bin < rc::profiler::Bins; ++bin)
+		{
+			RC_TEST_EQUAL(stage.histogram[bin], expected[bin]);
+		}
+		RC_TEST_CHECK(stage.name == 0);
+	}
+	
+	// the dump shows all stages that have run, in microseconds
+	{
+		FILE* file = tmpfile();
+		FILE* old = stdout;
+		stdout = file;
+		rc::profiler::dump();
+		stdout = old;
+		
+		char text[1024];
+		rewind(file);
+		size_t length = fread(text, 1, sizeof(text) - 1, file);
+		text[length] = 0;
+		fclose(file);
+		
+		RC_TEST_CHECK(strstr(text, "busy       10   100   145   190 |    0    0    0    3    7    0    0    0\n") != 0);
+		RC_TEST_CHECK(strstr(text, "1           8     0") != 0);
+		RC_TEST_CHECK(strstr(text, "\n2 ") == 0);
+	}
+	
+	// reset keeps the names
+	rc::profiler::reset();
+	RC_TEST_EQUAL(rc::profiler::getStage(Stage_Busy).count, 0);
+	RC_TEST_EQUAL(rc::profiler::getStage(Stage_Busy).total, 0);
+	RC_TEST_EQUAL(rc::profiler::getStage(Stage_Busy).histogram[4], 0);
+	RC_TEST_CHECK(rc::profiler::getStage(Stage_Busy).name != 0);
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_pwmout.cpp
+** PWMOut pulses generated by the Timer1 hardware on pins 9 and 10
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <outputchannel.h>
+#include <PWMOut.h>
+#include <rc_host.h>
+#include <Timer1.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	CyclesPerTick = F_CPU / 2000000
+};
+
+
+static void nothing() { }
+
+
+int main()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	
+	rc::setOutputChannel(rc::OutputChannel_1, 1500);
+	rc::setOutputChannel(rc::OutputChannel_3, 1000);
+	
+	rc::PWMOut out(rc::OutputChannel_1);
+	RC_TEST_EQUAL(out.getChannel(9), rc::OutputChannel_1);
+	RC_TEST_EQUAL(out.getChannel(10), rc::OutputChannel_None);
+	out.setChannel(10, rc::OutputChannel_3);
+	RC_TEST_EQUAL(out.getChannel(10), rc::OutputChannel_3);
+	RC_TEST_EQUAL(out.getFrameLength(), 20000);
+	out.setFrameLength(3000);
+	
+	// Timer1 isn't taken over while someone else has claimed part of it
+	rc::Timer1::start();
+	RC_TEST_CHECK(rc::Timer1::isClaimed() == false);
+	RC_TEST_EQUAL(rc::Timer1::claimCompare(nothing, 100), rc::Timer1::Compare_B);
+	RC_TEST_CHECK(rc::Timer1::isClaimed());
+	out.start();
+	out.stop();
+	rc::host::advanceMicros(10000);
+	RC_TEST_CHECK(rc::Timer1::isFastPWM() == false);
+	RC_TEST_CHECK(rc::Timer1::isRunning());
+	RC_TEST_EQUAL(rc::host::getEdgeCount(), 0);
+	rc::Timer1::releaseCompare(rc::Timer1::Compare_B);
+	RC_TEST_CHECK(rc::Timer1::addOverflowHook(nothing));
+	out.start();
+	RC_TEST_CHECK(rc::Timer1::isFastPWM() == false);
+	rc::Timer1::removeOverflowHook(nothing);
+	
+	out.start();
+	RC_TEST_CHECK(rc::Timer1::isFastPWM());
+	rc::host::advanceMicros(10000);
+	
+	// and while it's in use compare units can't be claimed
+	RC_TEST_EQUAL(rc::Timer1::claimCompare(nothing, 100), rc::Timer1::Compare_None);
+	
+	// both pins start together, every 3 ms. The chip clears a pin one tick after the
+	// compare match, the simulator right at it, so pulses here are one tick short
+	uint32_t frame = findEdge(9, true, 0);
+	RC_TEST_EQUAL(findEdge(10, true, 0), frame);
+	RC_TEST_EQUAL(findEdge(9, true, frame + 1) - frame, 3000 * 2 * CyclesPerTick);
+	RC_TEST_EQUAL(pulseTicks(9, frame), 1500 * 2 - 1);
+	RC_TEST_EQUAL(pulseTicks(10, frame), 1000 * 2 - 1);
+	
+	// no interrupts at all
+	RC_TEST_EQUAL(TIMSK1, 0);
+	
+	// a new value during a pulse is used from the next frame on
+	frame = findEdge(9, true, rc::host::getCycles() - 3000 * 2 * CyclesPerTick);
+	rc::host::advance(frame + 500 * 2 * CyclesPerTick - rc::host::getCycles() + 3000 * 2 * CyclesPerTick);
+	frame += 3000 * 2 * CyclesPerTick;
+	rc::setOutputChannel(rc::OutputChannel_1, 2000);
+	out.update();
+	rc::host::advanceMicros(6000);
+	RC_TEST_EQUAL(pulseTicks(9, frame), 1500 * 2 - 1);
+	RC_TEST_EQUAL(pulseTicks(9, frame + 1), 2000 * 2 - 1);
+	
+	// a channel of 0 keeps the pin low, the pulse in progress isn't cut short
+	rc::setOutputChannel(rc::OutputChannel_3, 0);
+	out.update();
+	RC_TEST_CHECK(rc::host::getPin(10));
+	rc::host::advanceMicros(1500);
+	RC_TEST_CHECK(rc::host::getPin(10) == false);
+	out.update();
+	rc::host::advanceMicros(6000);
+	rc::host::clearEdges();
+	rc::host::advanceMicros(6000);
+	RC_TEST_EQUAL(findEdge(10, true, 0), 0);
+	RC_TEST_CHECK(findEdge(9, true, 0) != 0);
+	rc::setOutputChannel(rc::OutputChannel_3, 1200);
+	out.update();
+	rc::host::advanceMicros(6000);
+	RC_TEST_EQUAL(pulseTicks(10, findEdge(10, true, 0)), 1200 * 2 - 1);
+	
+	// stopped, the timer is back in normal mode and both pins are low
+	out.stop();
+	rc::host::advanceMicros(3000);
+	RC_TEST_CHECK(rc::Timer1::isRunning() == false);
+	RC_TEST_EQUAL(TCCR1A, 0);
+	RC_TEST_CHECK(rc::host::getPin(9) == false);
+	RC_TEST_CHECK(rc::host::getPin(10) == false);
+	
+	return RC_TEST_RESULT();
+}
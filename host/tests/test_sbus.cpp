@@ -0,0 +1,348 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_sbus.cpp
+** SBUSIn decoding of recorded SBUS byte streams, SBUSOut frames and SBUSOut to SBUSIn loopback
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <inputchannel.h>
+#include <outputchannel.h>
+#include <rc_host.h>
+#include <rc_tick.h>
+#include <SBUSIn.h>
+#include <SBUSOut.h>
+#include <Timer1.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	FrameSize = 25,
+	ByteTime  = 120,  // 12 bits at 100000 baud
+	FrameGap  = 4000  // between the end of a frame and the start of the next one
+};
+
+// all channels at 992
+static const uint8_t s_center[FrameSize] =
+{
+	0x0F, 0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0xE0,
+	0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C, 0x00, 0x00
+};
+
+// 172, 1811, 992, 1500, 500, 1000, 1200, 1400, 1600, 1800, 200, 400, 600, 800, 15, 2047
+// channel 17 on, SBUS2 footer
+static const uint8_t s_varied[FrameSize] =
+{
+	0x0F, 0xAC, 0x98, 0x38, 0xF8, 0xB8, 0x4B, 0x1F, 0xF4, 0xC1, 0x12, 0xAF, 0x40,
+	0x46, 0x38, 0x32, 0x20, 0x83, 0x25, 0x90, 0x3D, 0xE0, 0xFF, 0x01, 0x04
+};
+
+static const uint16_t s_variedMicros[16] =
+{
+	987, 2011, 1500, 1817, 1192, 1505, 1630, 1755, 1880, 2005, 1005, 1130, 1255, 1380, 889, 2159
+};
+
+
+static void feed(rc::SBUSIn& p_in, const uint8_t* p_bytes, uint8_t p_count, uint8_t p_flags = 0xFF, uint8_t p_invalid = 0xFF)
+{
+	for (uint8_t i = 0; i < p_count; ++i)
+	{
+		uint8_t data = p_bytes[i];
+		if (i == FrameSize - 2 && p_flags != 0xFF)
+		{
+			data = p_flags;
+		}
+		p_in.byteReceived(data, i != p_invalid);
+		rc::host::advanceMicros(ByteTime);
+	}
+}
+
+
+static void feedFrame(rc::SBUSIn& p_in, const uint8_t* p_bytes, uint8_t p_flags = 0xFF, uint8_t p_invalid = 0xFF)
+{
+	feed(p_in, p_bytes, FrameSize, p_flags, p_invalid);
+	rc::host::advanceMicros(FrameGap);
+}
+
+
+static void checkChannels(const uint16_t* p_values)
+{
+	for (uint8_t i = 0; i < 16 && i < RC_MAX_CHANNELS; ++i)
+	{
+		RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), p_values[i]);
+	}
+}
+
+
+static void checkCenter()
+{
+	for (uint8_t i = 0; i < 16 && i < RC_MAX_CHANNELS; ++i)
+	{
+		RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), 1500);
+	}
+}
+
+
+static void setOutputChannels(uint16_t p_value)
+{
+	for (uint8_t i = 0; i < 16 && i < RC_MAX_CHANNELS; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), p_value);
+	}
+}
+
+
+// Frames sent by SBUSOut, byte for byte
+static void checkOutput()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	setOutputChannels(1500);
+#if RC_MAX_CHANNELS >= 18
+	rc::setOutputChannel(static_cast<rc::OutputChannel>(16), 2000);
+	rc::setOutputChannel(static_cast<rc::OutputChannel>(17), 1000);
+#endif
+	
+	rc::SBUSOut out;
+	out.setFrameLength(7000);
+	out.start();
+	RC_TEST_CHECK(out.update());
+	RC_TEST_CHECK(out.update() == false);
+	
+	// 12 bits per byte at 100000 baud, back to back
+	rc::host::advanceMicros(FrameSize * ByteTime + 100);
+	RC_TEST_EQUAL(rc::host::getUartByteCount(), FrameSize);
+	for (uint8_t i = 0; i < FrameSize; ++i)
+	{
+		RC_TEST_EQUAL(rc::host::getUartByte(i).data, i == FrameSize - 2 && RC_MAX_CHANNELS >= 18 ? 0x01 : s_center[i]);
+	}
+	for (uint8_t i = 1; i < FrameSize; ++i)
+	{
+		RC_TEST_EQUAL(rc::host::getUartByte(i).cycle - rc::host::getUartByte(i - 1).cycle, ByteTime * 16);
+	}
+	
+	// channels are read when a frame is started, frames start every 7 ms
+	setOutputChannels(1000);
+	rc::setOutputChannel(rc::OutputChannel_1, 1500);
+	rc::host::clearUartBytes();
+	uint8_t frames = 0;
+	for (uint16_t i = 0; i < 500; ++i)
+	{
+		if (out.update())
+		{
+			++frames;
+		}
+		rc::host::advanceMicros(100);
+	}
+	RC_TEST_EQUAL(frames, 7);
+	RC_TEST_EQUAL(rc::host::getUartByteCount(), 7 * FrameSize);
+	for (uint8_t f = 0; f < 7; ++f)
+	{
+		const rc::host::UartByte& first = rc::host::getUartByte(f * FrameSize);
+		RC_TEST_EQUAL(first.data, 0x0F);
+		RC_TEST_EQUAL(rc::host::getUartByte(f * FrameSize + 1).data, 0xE0); // 992, low byte
+		if (f > 0)
+		{
+			RC_TEST_EQUAL((first.cycle - rc::host::getUartByte((f - 1) * FrameSize).cycle) / 16, 7000);
+		}
+	}
+	
+	// late updates don't slow the frame rate down
+	rc::host::clearUartBytes();
+	frames = 0;
+	for (uint16_t i = 0; i < 700; ++i)
+	{
+		if (out.update())
+		{
+			++frames;
+		}
+		rc::host::advanceMicros(300);
+	}
+	RC_TEST_EQUAL(frames, 30);
+	
+	out.setFailsafe(true);
+	rc::host::advanceMicros(7000);
+	rc::host::clearUartBytes();
+	RC_TEST_CHECK(out.update());
+	rc::host::advanceMicros(FrameSize * ByteTime + 100);
+	RC_TEST_EQUAL(rc::host::getUartByte(FrameSize - 2).data, 0x09);
+	out.stop();
+}
+
+
+// SBUSOut to SBUSIn, both through the UART interrupt handlers
+static void checkLoopback()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	rc::host::setUartLoopback(true);
+	
+	rc::SBUSIn in;
+	in.start();
+	rc::SBUSOut out;
+	out.start();
+	
+	// the frame time is sampled once and never again, the failsafe mustn't depend on it
+	rc::tick::update();
+	
+	// every value SBUSIn can produce makes it back unchanged,
+	// SBUS has more values than microseconds so the bytes may differ from what a receiver sends
+	for (uint16_t base = 880; base < 2160; base += 16)
+	{
+		for (uint8_t i = 0; i < 16; ++i)
+		{
+			rc::setOutputChannel(static_cast<rc::OutputChannel>(i), base + i);
+		}
+		rc::host::advanceMicros(out.getFrameLength());
+		RC_TEST_CHECK(out.update());
+		rc::host::advanceMicros(FrameSize * ByteTime + 100);
+		RC_TEST_CHECK(in.update());
+		for (uint8_t i = 0; i < 16; ++i)
+		{
+			uint16_t expected = base + i;
+			if (rc::getInputChannel(static_cast<rc::InputChannel>(i)) != expected)
+			{
+				RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), expected);
+			}
+		}
+	}
+	RC_TEST_CHECK(in.isStable());
+	RC_TEST_EQUAL(in.getDroppedFrames(), 0);
+	
+	// without frames the signal is lost after the timeout
+	rc::host::advanceMicros(in.getTimeout() * 1000UL - 10000);
+	RC_TEST_CHECK(in.update() == false);
+	RC_TEST_CHECK(in.isStable());
+	rc::host::advanceMicros(20000);
+	RC_TEST_CHECK(in.update() == false);
+	RC_TEST_CHECK(in.isStable() == false);
+	
+	// failsafe on the way out is failsafe on the way in
+	out.setFailsafe(true);
+	rc::host::advanceMicros(out.getFrameLength());
+	RC_TEST_CHECK(out.update());
+	rc::host::advanceMicros(FrameSize * ByteTime + 100);
+	RC_TEST_CHECK(in.update() == false);
+	RC_TEST_CHECK(in.isLost());
+	
+	out.stop();
+	in.stop();
+}
+
+
+int main()
+{
+	checkOutput();
+	checkLoopback();
+	
+	rc::host::reset();
+	rc::Timer1::init();
+	
+	rc::SBUSIn in;
+	in.start();
+	RC_TEST_CHECK(in.update() == false);
+	RC_TEST_CHECK(in.isStable() == false);
+	RC_TEST_CHECK(in.isLost() == false);
+	
+	// a plain frame
+	feedFrame(in, s_center);
+	RC_TEST_CHECK(in.update());
+	RC_TEST_CHECK(in.isStable());
+	RC_TEST_CHECK(in.update() == false);
+	checkCenter();
+	
+	// all channel bits, digital channel 17 and an SBUS2 footer
+	feedFrame(in, s_varied);
+	RC_TEST_CHECK(in.update());
+	checkChannels(s_variedMicros);
+#if RC_MAX_CHANNELS >= 18
+	RC_TEST_EQUAL(in.getChannels(), 18);
+	RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(16)), 2000);
+	RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(17)), 1000);
+#else
+	RC_TEST_EQUAL(in.getChannels(), RC_MAX_CHANNELS);
+#endif
+	
+	// the stream starts in the middle of a frame, at a data byte that looks like a header
+	feed(in, s_varied + 11, FrameSize - 11);
+	rc::host::advanceMicros(FrameGap);
+	RC_TEST_CHECK(in.update() == false);
+	feedFrame(in, s_center);
+	RC_TEST_CHECK(in.update());
+	checkCenter();
+	
+	// a byte with a framing or parity error drops the frame
+	feedFrame(in, s_varied, 0xFF, 7);
+	RC_TEST_CHECK(in.update() == false);
+	checkCenter();
+	
+	// a bad footer drops the frame
+	{
+		uint8_t frame[FrameSize];
+		for (uint8_t i = 0; i < FrameSize; ++i)
+		{
+			frame[i] = s_varied[i];
+		}
+		frame[FrameSize - 1] = 0x55;
+		feedFrame(in, frame);
+		RC_TEST_CHECK(in.update() == false);
+		checkCenter();
+	}
+	
+	// a gap in the middle of a frame restarts at the next header
+	feed(in, s_varied, 10);
+	rc::host::advanceMicros(FrameGap);
+	feedFrame(in, s_varied);
+	RC_TEST_CHECK(in.update());
+	checkChannels(s_variedMicros);
+	
+	// frames received between updates are counted as dropped
+	uint16_t dropped = in.getDroppedFrames();
+	feedFrame(in, s_center);
+	feedFrame(in, s_center);
+	feedFrame(in, s_varied);
+	RC_TEST_CHECK(in.update());
+	RC_TEST_EQUAL(in.getDroppedFrames() - dropped, 2);
+	checkChannels(s_variedMicros);
+	
+	// receiver reports a frame lost, the channels are still valid
+	RC_TEST_EQUAL(in.getLostFrames(), 0);
+	feedFrame(in, s_center, 0x04);
+	RC_TEST_CHECK(in.update());
+	RC_TEST_CHECK(in.isStable());
+	RC_TEST_EQUAL(in.getLostFrames(), 1);
+	checkCenter();
+	
+	// failsafe, the channels keep their last values
+	feedFrame(in, s_varied, 0x0C);
+	RC_TEST_CHECK(in.update() == false);
+	RC_TEST_CHECK(in.isLost());
+	checkCenter();
+	
+	// and back
+	feedFrame(in, s_varied);
+	RC_TEST_CHECK(in.update());
+	RC_TEST_CHECK(in.isStable());
+	checkChannels(s_variedMicros);
+	
+	// pull the plug
+	in.setTimeout(100);
+	rc::host::advanceMicros(50000);
+	in.update();
+	RC_TEST_CHECK(in.isStable());
+	rc::host::advanceMicros(60000);
+	in.update();
+	RC_TEST_CHECK(in.isLost());
+	in.stop();
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,120 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_servoin.cpp
+** ServoIn decoding of pulses on pins spread over all three ports
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <inputchannel.h>
+#include <rc_host.h>
+#include <ServoIn.h>
+#include <Timer1.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	Servos = 8
+};
+
+static const uint8_t  s_pins[Servos]   = { 2, 3, 4, 5, 8, 12, A0, A1 };
+static const uint16_t s_values[Servos] = { 1000, 1100, 1250, 1500, 1520, 1750, 1900, 2000 };
+
+
+int main()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	
+	rc::ServoIn in;
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		in.setPin(i, s_pins[i]);
+	}
+	for (uint8_t i = Servos; i < RC_MAX_CHANNELS; ++i)
+	{
+		in.setPin(i, 0);
+	}
+	in.start();
+	
+	// one pulse after the other
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		rc::host::advanceMicros(100);
+		rc::host::setPin(s_pins[i], true);
+		rc::host::advanceMicros(s_values[i]);
+		rc::host::setPin(s_pins[i], false);
+	}
+	in.update();
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), s_values[i]);
+	}
+	
+	// pins on the same port changing at the same time, one interrupt handles all of them
+	rc::host::advanceMicros(100);
+	cli();
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		rc::host::setPin(s_pins[i], true);
+	}
+	sei();
+	rc::host::sync();
+	
+	rc::host::advanceMicros(1200);
+	cli();
+	rc::host::setPin(2, false); // port D
+	rc::host::setPin(3, false);
+	rc::host::setPin(8, false); // port B
+	rc::host::setPin(12, false);
+	sei();
+	rc::host::sync();
+	
+	rc::host::advanceMicros(600);
+	cli();
+	rc::host::setPin(4, false);
+	rc::host::setPin(5, false);
+	rc::host::setPin(A0, false); // port C
+	rc::host::setPin(A1, false);
+	sei();
+	rc::host::sync();
+	
+	in.update();
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		bool first = s_pins[i] == 2 || s_pins[i] == 3 || s_pins[i] == 8 || s_pins[i] == 12;
+		RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), first ? 1200 : 1800);
+	}
+	
+	// statistics, the longest gap is between the two pulses of the first servo
+	rc::InputStats stats;
+	in.getStats(stats);
+	RC_TEST_EQUAL(stats.frames, 2 * Servos);
+	RC_TEST_EQUAL(stats.confused, 0);
+	RC_TEST_NEAR(stats.maxGap, 100 * Servos + 12020, 2);
+	
+	// a pulse that was already going on when starting has no start
+	in.stop();
+	in.resetStats();
+	in.start();
+	rc::host::setPin(2, true);
+	in.start();
+	rc::host::advanceMicros(1000);
+	rc::host::setPin(2, false);
+	in.getStats(stats);
+	RC_TEST_EQUAL(stats.frames, 0);
+	RC_TEST_EQUAL(stats.confused, 1);
+	RC_TEST_EQUAL(stats.maxGap, 0);
+	
+	in.stop();
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,212 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_servoout.cpp
+** ServoOut pulses, one after the other and in banks
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <outputchannel.h>
+#include <rc_host.h>
+#include <ServoOut.h>
+#include <Timer1.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	Servos = 8,
+	
+	CyclesPerMicro = F_CPU / 1000000
+};
+
+// pins 2 - 7 are on port D, 8 and 9 on port B
+static uint8_t        s_pins[RC_MAX_CHANNELS] = { 2, 3, 4, 5, 6, 7, 8, 9 };
+static const uint16_t s_values[Servos]        = { 1000, 1500, 2000, 1500, 1505, 1100, 1800, 1000 };
+
+
+static uint16_t s_interrupts = 0; //!< Number of compare match interrupts.
+
+
+static void countInterrupt()
+{
+	++s_interrupts;
+	rc::ServoOut::handleInterrupt();
+}
+
+
+int main()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		pinMode(s_pins[i], OUTPUT);
+		digitalWrite(s_pins[i], LOW);
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), s_values[i]);
+	}
+	
+	rc::ServoOut out(s_pins);
+	RC_TEST_EQUAL(out.getBankSize(), 1);
+	out.start();
+	rc::Timer1::setCompareMatch(true, false, countInterrupt);
+	rc::host::advanceMicros(out.getPauseLength() + 15000);
+	
+	// one after the other, each pulse starts when the previous one ends
+	uint32_t frame = findEdge(s_pins[0], true, 0);
+	uint32_t time  = frame;
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		RC_TEST_EQUAL(findEdge(s_pins[i], true, frame), time);
+		RC_TEST_EQUAL(pulseLength(s_pins[i], frame), s_values[i]);
+		time += s_values[i] * CyclesPerMicro;
+	}
+	rc::host::advanceMicros(20000);
+	
+	// the pulses take longer than the pause length, the next frame follows them after a short pause
+	uint32_t next = findEdge(s_pins[0], true, frame + 1);
+	RC_TEST_CHECK(next > time);
+	RC_TEST_CHECK(next - time < 50 * CyclesPerMicro);
+	
+	// in banks, all pins of a port start at the same time
+	out.setBankSize(8);
+	RC_TEST_EQUAL(out.getBankSize(), 8);
+	out.setPauseLength(5000);
+	out.update();
+	rc::host::advanceMicros(20000);
+	rc::host::clearEdges();
+	rc::host::advanceMicros(10000);
+	
+	frame = findEdge(s_pins[0], true, 0);
+	for (uint8_t i = 0; i < 6; ++i)
+	{
+		RC_TEST_EQUAL(findEdge(s_pins[i], true, frame), frame);
+		
+		// the pulses ending at 1500 and 1505 us end together halfway, in timer ticks
+		uint16_t expected = (s_values[i] == 1500 || s_values[i] == 1505) ? 3005 : s_values[i] << 1;
+		RC_TEST_EQUAL(pulseTicks(s_pins[i], frame), expected);
+	}
+	
+	// equal pulses end at the same time
+	RC_TEST_EQUAL(findEdge(s_pins[1], false, frame), findEdge(s_pins[3], false, frame));
+	
+	// the bank on port B starts when the longest pulse of port D ends
+	uint32_t bank = frame + 2000 * CyclesPerMicro;
+	RC_TEST_EQUAL(findEdge(s_pins[6], true, frame), bank);
+	RC_TEST_EQUAL(findEdge(s_pins[7], true, frame), bank);
+	RC_TEST_EQUAL(pulseLength(s_pins[6], frame), s_values[6]);
+	RC_TEST_EQUAL(pulseLength(s_pins[7], frame), s_values[7]);
+	
+	// 200 Hz
+	RC_TEST_EQUAL((findEdge(s_pins[0], true, frame + 1) - frame) / CyclesPerMicro, 5000);
+	
+	// seven interrupts per frame; the start of port D, the ends at 1000, 1100, 1500 and 2000 us,
+	// the last one starts port B as well, and the ends of port B at 1000 and 1800 us
+	s_interrupts = 0;
+	rc::host::advanceMicros(50000);
+	RC_TEST_NEAR(s_interrupts, 70, 1);
+	
+	// pulses ending within the merge window end together, with a single write
+	rc::setOutputChannel(rc::OutputChannel_6, 1020);
+	out.update();
+	rc::host::advanceMicros(10000);
+	s_interrupts = 0;
+	rc::host::advanceMicros(50000);
+	RC_TEST_NEAR(s_interrupts, 70, 1);
+	RC_TEST_EQUAL(out.getMergeWindow(), 0);
+	out.setMergeWindow(32);
+	RC_TEST_EQUAL(out.getMergeWindow(), 32);
+	out.update();
+	rc::host::advanceMicros(10000);
+	rc::host::clearEdges();
+	s_interrupts = 0;
+	rc::host::advanceMicros(50000);
+	RC_TEST_NEAR(s_interrupts, 60, 1);
+	frame = findEdge(s_pins[0], true, 0);
+	RC_TEST_EQUAL(findEdge(s_pins[5], false, frame), findEdge(s_pins[0], false, frame));
+	RC_TEST_EQUAL(pulseLength(s_pins[0], frame), 1010);
+	RC_TEST_EQUAL(pulseLength(s_pins[5], frame), 1010);
+	out.setMergeWindow(0);
+	
+	// with the default window no pulse is off by more than 8 us, while ends that follow each other
+	// closely are still at least 16 us apart for the interrupt routine
+	static const uint16_t s_close[6] = { 1000, 1015, 1016, 1031, 1032, 1047 };
+	for (uint8_t i = 0; i < 6; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), s_close[i]);
+	}
+	out.update();
+	rc::host::advanceMicros(10000);
+	rc::host::clearEdges();
+	rc::host::advanceMicros(10000);
+	frame = findEdge(s_pins[0], true, 0);
+	uint32_t previous = frame;
+	for (uint8_t i = 0; i < 6; ++i)
+	{
+		RC_TEST_NEAR(pulseTicks(s_pins[i], frame), s_close[i] << 1, 15);
+		uint32_t fall = findEdge(s_pins[i], false, frame);
+		RC_TEST_CHECK(fall == previous || fall - previous >= 16 * CyclesPerMicro);
+		previous = fall;
+	}
+	RC_TEST_EQUAL(pulseTicks(s_pins[0], frame), 2015);
+	RC_TEST_EQUAL(pulseTicks(s_pins[1], frame), 2015);
+	RC_TEST_EQUAL(pulseTicks(s_pins[2], frame), 2047);
+	for (uint8_t i = 0; i < 6; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), s_values[i]);
+	}
+	
+	// a bank size of 4 splits port D, the second bank starts after the 2000 us pulse
+	out.setBankSize(4);
+	out.update();
+	rc::host::advanceMicros(10000);
+	rc::host::clearEdges();
+	rc::host::advanceMicros(10000);
+	frame = findEdge(s_pins[0], true, 0);
+	RC_TEST_EQUAL(findEdge(s_pins[3], true, frame), frame);
+	RC_TEST_EQUAL(findEdge(s_pins[4], true, frame), frame + 2000 * CyclesPerMicro);
+	RC_TEST_EQUAL(findEdge(s_pins[5], true, frame), frame + 2000 * CyclesPerMicro);
+	RC_TEST_EQUAL(findEdge(s_pins[6], true, frame), frame + 3505 * CyclesPerMicro);
+	
+	// a new frame is only sent after the current one, every pin is low in between
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), 1200);
+	}
+	frame = findEdge(s_pins[0], true, rc::host::getCycles() - 5000 * CyclesPerMicro);
+	rc::host::advanceMicros(10);
+	out.update();
+	rc::host::advanceMicros(10000);
+	RC_TEST_EQUAL(pulseLength(s_pins[2], frame), 2000);
+	uint32_t end = findEdge(s_pins[0], true, frame + 1);
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		RC_TEST_EQUAL(pulseLength(s_pins[i], end), 1200);
+	}
+	
+	// without any servos nothing happens
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), 0);
+	}
+	out.update();
+	rc::host::advanceMicros(10000);
+	rc::host::clearEdges();
+	rc::host::advanceMicros(50000);
+	RC_TEST_EQUAL(rc::host::getEdgeCount(), 0);
+	for (uint8_t i = 0; i < Servos; ++i)
+	{
+		RC_TEST_CHECK(rc::host::getPin(s_pins[i]) == false);
+	}
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,83 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_tick.cpp
+** Frame time sampled once per loop, and Channel speed working from it
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <Channel.h>
+#include <rc_host.h>
+#include <rc_tick.h>
+#include <util.h>
+
+#include "rc_test.h"
+
+
+int main()
+{
+	rc::host::reset();
+	
+	// without update the live time is used
+	rc::host::advanceMicros(1500);
+	RC_TEST_EQUAL(rc::tick::getMillis(), 1);
+	RC_TEST_EQUAL(rc::tick::getMicros(), 1500);
+	RC_TEST_EQUAL(rc::tick::getDelta(), 0);
+	
+	// the first update carries on from millis()
+	rc::tick::update();
+	RC_TEST_EQUAL(rc::tick::getMillis(), 1);
+	RC_TEST_EQUAL(rc::tick::getMicros(), 1500);
+	
+	// within a frame the time stands still
+	rc::host::advanceMicros(700);
+	RC_TEST_EQUAL(rc::tick::getMillis(), 1);
+	RC_TEST_EQUAL(rc::tick::getMicros(), 1500);
+	
+	// frames of 2.5 ms, the milliseconds don't drift
+	rc::host::advanceMicros(1800);
+	for (uint8_t i = 0; i < 40; ++i)
+	{
+		rc::tick::update();
+		RC_TEST_EQUAL(rc::tick::getDelta(), 2500);
+		RC_TEST_EQUAL(rc::tick::getMicros(), 4000 + i * 2500UL);
+		rc::host::advanceMicros(2500);
+	}
+	RC_TEST_EQUAL(rc::tick::getMillis(), 101);
+	
+	// a long stall
+	rc::host::advanceMicros(100000000UL - 2500);
+	rc::tick::update();
+	RC_TEST_EQUAL(rc::tick::getDelta(), 0xFFFF);
+	RC_TEST_EQUAL(rc::tick::getMillis(), static_cast<uint16_t>(101 + 100000));
+	RC_TEST_EQUAL(rc::tick::getMillis(), static_cast<uint16_t>(millis()));
+	
+	// a servo that has been standing still for a second starts moving at its speed, it doesn't jump
+	rc::Channel channel;
+	channel.setSpeed(10); // a full throw of 512 takes a second
+	channel.apply(0);
+	for (uint8_t i = 0; i < 50; ++i)
+	{
+		rc::host::advanceMicros(20000);
+		rc::tick::update();
+		channel.apply(0);
+	}
+	rc::host::advanceMicros(20000);
+	rc::tick::update();
+	RC_TEST_EQUAL(channel.apply(256), rc::normalizedToMicros((20 * 128) / (10 * 25)));
+	
+	// without updates the time stands still, update() is needed every loop
+	rc::tick::update();
+	uint16_t frame = rc::tick::getMillis();
+	rc::host::advanceMicros(1000000);
+	RC_TEST_EQUAL(rc::tick::getMillis(), frame);
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,208 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_timer1.cpp
+** Timer1 32 bit time, compare unit claims, overflow hooks and several users sharing the timer
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <inputchannel.h>
+#include <outputchannel.h>
+#include <PPMIn.h>
+#include <PPMOut.h>
+#include <rc_host.h>
+#include <ServoIn.h>
+#include <ServoOut.h>
+#include <Timer1.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	CyclesPerMicro = 16,
+	Channels       = 4,
+	FrameLength    = 16000 // sum of s_values + pause
+};
+
+static const uint16_t s_values[Channels] = { 1000, 1250, 1750, 2000 };
+static const uint8_t  s_servoPins[RC_MAX_CHANNELS] = { 2, 3 };
+
+static uint16_t s_hooks[2] = { 0, 0 };
+
+
+static void hookA() { ++s_hooks[0]; }
+static void hookB() { ++s_hooks[1]; }
+static void nothing() { }
+
+
+int main()
+{
+	rc::host::reset();
+	rc::Timer1::init();
+	rc::Timer1::start();
+	
+	// the time goes on past overflows of the counter
+	uint32_t last = rc::Timer1::getTime();
+	for (uint16_t i = 0; i < 200; ++i)
+	{
+		rc::host::advanceMicros(1003);
+		uint32_t now = rc::Timer1::getTime();
+		RC_TEST_NEAR(now - last, 2006, 2);
+		last = now;
+	}
+	RC_TEST_CHECK(last > 0x10000UL * 6);
+	
+	// an overflow which the interrupt routine hasn't handled yet
+	while (TCNT1 < 0xFF00)
+	{
+		rc::host::advanceMicros(10);
+	}
+	last = rc::Timer1::getTime();
+	cli();
+	rc::host::advanceMicros(200);
+	RC_TEST_NEAR(rc::Timer1::getTime() - last, 400, 2);
+	sei();
+	rc::host::sync();
+	RC_TEST_NEAR(rc::Timer1::getTime() - last, 400, 2);
+	
+	// compare units are handed out once, B first
+	RC_TEST_EQUAL(rc::Timer1::claimCompare(nothing, 100, rc::Timer1::Compare_A), rc::Timer1::Compare_A);
+	RC_TEST_EQUAL(rc::Timer1::claimCompare(nothing, 100, rc::Timer1::Compare_A), rc::Timer1::Compare_None);
+	RC_TEST_EQUAL(rc::Timer1::claimCompare(nothing, 100), rc::Timer1::Compare_B);
+	RC_TEST_EQUAL(rc::Timer1::claimCompare(nothing, 100), rc::Timer1::Compare_None);
+	rc::Timer1::releaseCompare(rc::Timer1::Compare_A);
+	RC_TEST_EQUAL(rc::Timer1::claimCompare(nothing, 100), rc::Timer1::Compare_A);
+	rc::Timer1::releaseCompare(rc::Timer1::Compare_A);
+	rc::Timer1::releaseCompare(rc::Timer1::Compare_B);
+	RC_TEST_EQUAL(TIMSK1 & (_BV(OCIE1A) | _BV(OCIE1B)), 0);
+	
+	// overflow hooks, as many as there's room for
+	RC_TEST_CHECK(rc::Timer1::addOverflowHook(hookA));
+	RC_TEST_CHECK(rc::Timer1::addOverflowHook(hookB));
+	RC_TEST_CHECK(rc::Timer1::addOverflowHook(nothing) == false);
+	rc::host::advanceMicros(32768 * 4);
+	RC_TEST_NEAR(s_hooks[0], 4, 1);
+	RC_TEST_EQUAL(s_hooks[1], s_hooks[0]);
+	rc::Timer1::removeOverflowHook(hookA);
+	rc::host::advanceMicros(32768 * 4);
+	RC_TEST_NEAR(s_hooks[1] - s_hooks[0], 4, 1);
+	rc::Timer1::removeOverflowHook(hookB);
+	
+	// PPM in and out with servos at the same time
+	rc::host::reset();
+	rc::Timer1::init();
+	rc::host::connect(9, 8);
+	for (uint8_t i = 0; i < Channels; ++i)
+	{
+		rc::setOutputChannel(static_cast<rc::OutputChannel>(i), s_values[i]);
+	}
+	for (uint8_t i = 0; i < 2; ++i)
+	{
+		pinMode(s_servoPins[i], OUTPUT);
+		digitalWrite(s_servoPins[i], LOW);
+	}
+	
+	rc::PPMIn ppmIn;
+	ppmIn.setPin(8);
+	ppmIn.setPauseLength(3000);
+	ppmIn.start();
+	
+	rc::PPMOut ppmOut(Channels);
+	ppmOut.setPauseLength(FrameLength - 6000);
+	ppmOut.start(9);
+	
+	rc::ServoOut servoOut(s_servoPins);
+	servoOut.start();
+	
+	// a ServoIn that's stopped leaves the timer running for the others
+	rc::ServoIn servoIn;
+	for (uint8_t i = 0; i < RC_MAX_CHANNELS; ++i)
+	{
+		servoIn.setPin(i, 0);
+	}
+	servoIn.setPin(0, 4);
+	servoIn.start();
+	servoIn.stop();
+	RC_TEST_CHECK(rc::Timer1::isRunning());
+	
+	for (uint8_t frame = 0; frame < 10; ++frame)
+	{
+		rc::host::advanceMicros(FrameLength);
+		ppmIn.update();
+	}
+	RC_TEST_CHECK(ppmIn.isStable());
+	RC_TEST_EQUAL(ppmIn.getChannels(), Channels);
+	for (uint8_t i = 0; i < Channels; ++i)
+	{
+		RC_TEST_EQUAL(rc::getInputChannel(static_cast<rc::InputChannel>(i)), s_values[i]);
+	}
+	
+	uint32_t from = rc::host::getCycles() - 30000UL * CyclesPerMicro;
+	RC_TEST_EQUAL(pulseLength(2, from), s_values[0]);
+	RC_TEST_EQUAL(pulseLength(3, from), s_values[1]);
+	
+	// stopping one output doesn't disturb the other
+	servoOut.stop();
+	rc::host::clearEdges();
+	for (uint8_t frame = 0; frame < 4; ++frame)
+	{
+		rc::host::advanceMicros(FrameLength);
+		RC_TEST_CHECK(ppmIn.update());
+	}
+	RC_TEST_CHECK(ppmIn.isStable());
+	RC_TEST_EQUAL(findEdge(2, true, 0), 0);
+	
+	// stopping in the middle of a pulse leaves the pins low, so the next start isn't inverted
+	servoOut.start();
+	rc::host::advanceMicros(FrameLength);
+	while (rc::host::getPin(2) == false)
+	{
+		rc::host::advanceMicros(10);
+	}
+	rc::host::advanceMicros(500);
+	servoOut.stop();
+	RC_TEST_CHECK(rc::host::getPin(2) == false);
+	servoOut.start();
+	rc::host::advanceMicros(FrameLength * 2);
+	from = rc::host::getCycles() - FrameLength * CyclesPerMicro;
+	RC_TEST_EQUAL(pulseLength(2, from), s_values[0]);
+	RC_TEST_EQUAL(pulseLength(3, from), s_values[1]);
+	
+	// PPM is low for the short pulses between channels, on pin 9 and on any other pin
+	from = findEdge(9, false, rc::host::getCycles() - FrameLength * CyclesPerMicro);
+	uint32_t gap = findEdge(9, true, from) - from;
+	for (uint8_t pin = 9; pin != 0; pin = (pin == 9) ? 7 : 0)
+	{
+		ppmOut.start(pin);
+		rc::host::advanceMicros(FrameLength);
+		while (rc::host::getPin(pin) == false)
+		{
+			rc::host::advanceMicros(10);
+		}
+		rc::host::advanceMicros(100);
+		ppmOut.stop();
+		RC_TEST_CHECK(rc::host::getPin(pin) == false);
+		ppmOut.start(pin);
+		rc::host::advanceMicros(FrameLength * 2);
+		from = findEdge(pin, false, rc::host::getCycles() - FrameLength * CyclesPerMicro);
+		RC_TEST_EQUAL(findEdge(pin, true, from) - from, gap);
+		ppmOut.stop();
+	}
+	
+	servoOut.stop();
+	ppmOut.start(9);
+	ppmOut.stop();
+	RC_TEST_EQUAL(TIMSK1 & (_BV(OCIE1A) | _BV(OCIE1B)), 0);
+	RC_TEST_EQUAL(TCCR1A & (_BV(COM1A1) | _BV(COM1A0)), 0);
+	ppmIn.stop();
+	
+	return RC_TEST_RESULT();
+}
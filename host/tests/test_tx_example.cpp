@@ -0,0 +1,76 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_tx_example.cpp
+** Runs the complete transmitter example and decodes its PPM signal
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+// the Arduino IDE includes Arduino.h in sketches
+#include <Arduino.h>
+#include "../../examples/TX_example/tx_example.pde"
+
+#include <inputchannel.h>
+#include <outputchannel.h>
+#include <PPMIn.h>
+#include <rc_host.h>
+
+#include "rc_test.h"
+
+
+int main()
+{
+	// the example's globals have been constructed by now, don't reset the registers they set up
+	sei();
+	rc::host::connect(9, 8);
+	
+	// sticks centered, throttle low, normal flight mode, throttle hold off
+	rc::host::setAnalog(A0, 515);
+	rc::host::setAnalog(A1, 544);
+	rc::host::setAnalog(A2, 27);
+	rc::host::setAnalog(A3, 502);
+	rc::host::setPin(3, false);
+	rc::host::setPin(4, true);
+	
+	// setup() initializes Timer1, start PPMIn after that
+	setup();
+	
+	rc::PPMIn in;
+	in.setPin(8);
+	in.setPauseLength(3000);
+	in.start();
+	
+	for (uint8_t frame = 0; frame < 10; ++frame)
+	{
+		loop();
+		rc::host::advanceMicros(22500);
+		in.update();
+	}
+	
+	RC_TEST_CHECK(in.isStable());
+	RC_TEST_EQUAL(in.getChannels(), ChannelCount);
+	for (uint8_t i = 0; i < ChannelCount; ++i)
+	{
+		RC_TEST_NEAR(rc::getInputChannel(static_cast<rc::InputChannel>(i)),
+		             rc::getOutputChannel(static_cast<rc::OutputChannel>(i)), 1);
+	}
+	
+	// full throttle, the throttle channel should follow
+	uint16_t low = rc::getOutputChannel(rc::OutputChannel_3);
+	rc::host::setAnalog(A2, 834);
+	for (uint8_t frame = 0; frame < 5; ++frame)
+	{
+		loop();
+		rc::host::advanceMicros(22500);
+		in.update();
+	}
+	RC_TEST_CHECK(rc::getOutputChannel(rc::OutputChannel_3) > low);
+	RC_TEST_NEAR(rc::getInputChannel(rc::InputChannel_3), rc::getOutputChannel(rc::OutputChannel_3), 1);
+	
+	return RC_TEST_RESULT();
+}
@@ -0,0 +1,135 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_uart.cpp
+** Ring buffered uart, writing and reading without waiting
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <rc_host.h>
+#include <rc_uart.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	ByteCycles = 10 * 8 * 17 // 115200 baud at double speed, UBRR 16
+};
+
+
+int main()
+{
+	rc::host::reset();
+	rc::uart::init(115200);
+	
+	// writing a lot at once doesn't take any time, what doesn't fit is dropped and counted
+	uint32_t start = rc::host::getCycles();
+	uint8_t accepted = 0;
+	for (uint8_t i = 0; i < 100; ++i)
+	{
+		if (rc::uart::put(i))
+		{
+			++accepted;
+		}
+	}
+	RC_TEST_EQUAL(rc::host::getCycles(), start);
+	RC_TEST_EQUAL(accepted, RC_UART_TX_SIZE - 1);
+	RC_TEST_EQUAL(rc::uart::getTxOverflows(), 100 - accepted);
+	
+	// the interrupt handler sends them, back to back and in order
+	rc::host::advance(ByteCycles * 100UL);
+	RC_TEST_EQUAL(rc::host::getUartByteCount(), accepted);
+	for (uint8_t i = 0; i < accepted; ++i)
+	{
+		RC_TEST_EQUAL(rc::host::getUartByte(i).data, i);
+		if (i > 0)
+		{
+			RC_TEST_EQUAL(rc::host::getUartByte(i).cycle - rc::host::getUartByte(i - 1).cycle, ByteCycles);
+		}
+	}
+	RC_TEST_CHECK((UCSR0B & _BV(UDRIE0)) == 0);
+	
+	// a buffer that doesn't fit is cut off, the bytes that do fit keep their order
+	{
+		uint8_t data[80];
+		for (uint8_t i = 0; i < sizeof(data); ++i)
+		{
+			data[i] = 200 - i;
+		}
+		rc::host::clearUartBytes();
+		uint16_t overflows = rc::uart::getTxOverflows();
+		RC_TEST_EQUAL(rc::uart::write(data, sizeof(data)), RC_UART_TX_SIZE - 1);
+		RC_TEST_EQUAL(rc::uart::getTxOverflows() - overflows, sizeof(data) - (RC_UART_TX_SIZE - 1));
+		rc::host::advance(ByteCycles * 100UL);
+		RC_TEST_EQUAL(rc::host::getUartByteCount(), RC_UART_TX_SIZE - 1);
+		for (uint8_t i = 0; i < RC_UART_TX_SIZE - 1; ++i)
+		{
+			RC_TEST_EQUAL(rc::host::getUartByte(i).data, data[i]);
+		}
+	}
+	
+	// receiving
+	uint8_t byte = 0;
+	RC_TEST_EQUAL(rc::uart::available(), 0);
+	RC_TEST_CHECK(rc::uart::read(byte) == false);
+	for (uint8_t i = 0; i < 5; ++i)
+	{
+		rc::host::uartReceive('a' + i);
+	}
+	RC_TEST_EQUAL(rc::uart::available(), 5);
+	for (uint8_t i = 0; i < 5; ++i)
+	{
+		RC_TEST_CHECK(rc::uart::read(byte));
+		RC_TEST_EQUAL(byte, 'a' + i);
+	}
+	RC_TEST_EQUAL(rc::uart::available(), 0);
+	
+	// a full receive buffer drops new bytes
+	for (uint8_t i = 0; i < RC_UART_RX_SIZE + 4; ++i)
+	{
+		rc::host::uartReceive(i);
+	}
+	RC_TEST_EQUAL(rc::uart::available(), RC_UART_RX_SIZE - 1);
+	RC_TEST_EQUAL(rc::uart::getRxOverflows(), 5);
+	for (uint8_t i = 0; i < RC_UART_RX_SIZE - 1; ++i)
+	{
+		RC_TEST_EQUAL(rc::uart::get(), i);
+	}
+	
+	// framing errors and overruns are dropped as well
+	rc::host::uartReceive('x', true);
+	cli();
+	rc::host::uartReceive('y');
+	rc::host::uartReceive('z');
+	sei();
+	rc::host::sync();
+	RC_TEST_EQUAL(rc::uart::getRxErrors(), 2);
+	RC_TEST_EQUAL(rc::uart::available(), 0);
+	
+	// loopback
+	rc::host::setUartLoopback(true);
+	const char* text = "hello";
+	RC_TEST_EQUAL(rc::uart::write(reinterpret_cast<const uint8_t*>(text), 5), 5);
+	rc::host::advance(ByteCycles * 6UL);
+	RC_TEST_EQUAL(rc::uart::available(), 5);
+	for (uint8_t i = 0; i < 5; ++i)
+	{
+		RC_TEST_EQUAL(rc::uart::get(), text[i]);
+	}
+	
+	// init starts over
+	rc::uart::init(9600);
+	RC_TEST_EQUAL(rc::uart::getTxOverflows(), 0);
+	RC_TEST_EQUAL(rc::uart::getRxOverflows(), 0);
+	RC_TEST_EQUAL(rc::uart::getRxErrors(), 0);
+	
+	return RC_TEST_RESULT();
+}
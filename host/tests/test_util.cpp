@@ -0,0 +1,129 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** test_util.cpp
+** Buffer conversions against the single value conversions
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <util.h>
+
+#include "rc_test.h"
+
+
+enum
+{
+	BufferSize = 255
+};
+
+
+static void checkMicros()
+{
+	uint16_t micros[BufferSize];
+	int16_t normal[BufferSize];
+	for (uint32_t start = 0; start <= 0xFFFF; start += BufferSize)
+	{
+		for (uint8_t i = 0; i < BufferSize; ++i)
+		{
+			micros[i] = static_cast<uint16_t>(start + i);
+		}
+		rc::microsToNormalized(micros, normal, BufferSize);
+		for (uint8_t i = 0; i < BufferSize; ++i)
+		{
+			RC_TEST_EQUAL(normal[i], rc::microsToNormalized(micros[i]));
+		}
+	}
+}
+
+
+static void checkNormalized()
+{
+	int16_t normal[513];
+	uint16_t micros[513];
+	for (int16_t i = 0; i < 513; ++i)
+	{
+		normal[i] = i - 256;
+	}
+	rc::normalizedToMicros(normal,       micros,       200);
+	rc::normalizedToMicros(normal + 200, micros + 200, 200);
+	rc::normalizedToMicros(normal + 400, micros + 400, 113);
+	for (int16_t i = 0; i < 513; ++i)
+	{
+		RC_TEST_EQUAL(micros[i], rc::normalizedToMicros(normal[i]));
+	}
+}
+
+
+// Every microsecond value in range survives packing, values outside are clipped
+static void checkPacked()
+{
+	uint8_t  packed[22];
+	uint16_t micros[16];
+	uint16_t result[16];
+	for (uint16_t base = 800; base < 2300; base += 16)
+	{
+		for (uint8_t i = 0; i < 16; ++i)
+		{
+			micros[i] = base + i;
+		}
+		rc::microsToPacked(micros, 16, packed);
+		rc::packedToMicros(packed, result, 16);
+		for (uint8_t i = 0; i < 16; ++i)
+		{
+			uint16_t expected = micros[i] < 880 ? 880 : (micros[i] > 2159 ? 2159 : micros[i]);
+			RC_TEST_EQUAL(result[i], expected);
+		}
+	}
+	
+	// missing channels are centered
+	rc::microsToPacked(micros, 3, packed);
+	rc::packedToMicros(packed, result, 16);
+	for (uint8_t i = 3; i < 16; ++i)
+	{
+		RC_TEST_EQUAL(result[i], 1500);
+	}
+}
+
+
+int main()
+{
+	checkPacked();
+	
+	rc::loadFutaba();
+	checkMicros();
+	checkNormalized();
+	
+	rc::setCenter(1500);
+	rc::setTravel(1000);
+	checkMicros();
+	checkNormalized();
+	
+	rc::setCenter(1234);
+	rc::setTravel(567);
+	checkMicros();
+	checkNormalized();
+	
+	// in place, odd counts so the tail of vectorized loops is used as well
+	uint16_t values[7] = { 0, 1, 2, 3000, 4001, 0xFFFE, 0xFFFF };
+	rc::ticksToMicros(values, values, 7);
+	RC_TEST_EQUAL(values[0], 0);
+	RC_TEST_EQUAL(values[1], 0);
+	RC_TEST_EQUAL(values[2], 1);
+	RC_TEST_EQUAL(values[3], 1500);
+	RC_TEST_EQUAL(values[4], 2000);
+	RC_TEST_EQUAL(values[5], 0x7FFF);
+	RC_TEST_EQUAL(values[6], 0x7FFF);
+	rc::microsToTicks(values, values, 5);
+	RC_TEST_EQUAL(values[3], 3000);
+	RC_TEST_EQUAL(values[4], 4000);
+	RC_TEST_EQUAL(values[5], 0x7FFF);
+	
+	return RC_TEST_RESULT();
+}
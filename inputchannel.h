@@ -96,6 +96,18 @@ namespace rc
 	/*! \brief Gets a pointer to the raw input channels buffer.
 	    \return Pointer to input channels buffer.*/
 	uint16_t* getRawInputChannels();
+	
+	
+	/*! \brief Statistics about the quality of an input signal.
+	    \details Kept by the interrupt routines of PPMIn and ServoIn, counters wrap around after 65535.*/
+	struct InputStats
+	{
+		uint32_t frames;         //!< Frames received, ServoIn counts pulses.
+		uint16_t confused;       //!< Frames thrown away because the signal wasn't what was expected.
+		uint16_t timeouts;       //!< Times the signal was lost, not detected by ServoIn.
+		uint16_t channelChanges; //!< Times the number of channels changed, not detected by ServoIn.
+		uint16_t maxGap;         //!< Longest time between two frames in microseconds, 65535 if longer.
+	};
 }
 
 #endif // INC_RC_INPUTCHANNEL_H
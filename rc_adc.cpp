@@ -0,0 +1,229 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_adc.cpp
+** Free running, oversampling ADC sampler
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#define RC_MODULE RC_MODULE_IO
+#include <rc_debug_lib.h>
+#include <rc_adc.h>
+
+
+#ifdef RC_USE_ADC
+
+#if RC_ADC_OVERSAMPLING < 0 || RC_ADC_OVERSAMPLING > 3
+	#error RC_ADC_OVERSAMPLING must be in the range [0 - 3]
+#endif
+
+namespace rc {
+namespace adc {
+
+enum
+{
+	Channels = 8,
+	Samples  = 1 << (2 * RC_ADC_OVERSAMPLING) //!< Conversions summed into one value
+};
+
+static volatile uint16_t s_values[Channels] = { 0 }; //!< Latest value of each channel
+static volatile uint8_t  s_enabled = 0;    //!< Channels being sampled, one bit per channel
+static volatile uint8_t  s_ready   = 0;    //!< Channels with a value, one bit per channel
+static volatile bool     s_running = false; //!< Whether the interrupt is converting channels
+static uint8_t  s_channel = 0;     //!< Channel being converted
+static uint8_t  s_count   = 0;     //!< Conversions summed so far
+static uint16_t s_sum     = 0;     //!< Sum of the conversions
+static bool     s_discard = false; //!< Whether to throw away the next conversion
+
+
+// Channel of an analog pin, takes A0 - A7 as well as the channel numbers analogRead takes
+static uint8_t toChannel(uint8_t p_pin)
+{
+	uint8_t channel = p_pin >= A0 ? p_pin - A0 : p_pin;
+	RC_ASSERT_MSG(channel < Channels, "pin %u has no ADC channel the sampler supports", p_pin);
+	return channel & (Channels - 1);
+}
+
+
+// Next enabled channel after p_channel, p_channel itself if it's the only one
+static uint8_t nextChannel(uint8_t p_channel)
+{
+	for (uint8_t i = 1; i <= Channels; ++i)
+	{
+		uint8_t channel = (p_channel + i) & (Channels - 1);
+		if (s_enabled & _BV(channel))
+		{
+			return channel;
+		}
+	}
+	return p_channel;
+}
+
+
+// Switches the multiplexer and starts a conversion, interrupts must be disabled
+static void startChannel(uint8_t p_channel)
+{
+	s_channel = p_channel;
+	s_count   = 0;
+	s_sum     = 0;
+	
+	// the sample and hold capacitor needs time to charge after switching,
+	// the first conversion also throws away a flag left by analogRead
+	s_discard = true;
+	ADMUX = _BV(REFS0) | p_channel;
+	
+	// prescaler 128 gives the 50 - 200 kHz ADC clock needed for full resolution at 16 MHz
+	ADCSRA = _BV(ADEN) | _BV(ADSC) | _BV(ADIE) | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+}
+
+
+// Public functions
+
+void enable(uint8_t p_pin)
+{
+	RC_TRACE("enable pin: %u", p_pin);
+	uint8_t mask = _BV(toChannel(p_pin));
+	
+	uint8_t oldSREG = SREG;
+	cli();
+	s_enabled |= mask;
+	s_ready &= ~mask;
+	if (s_running && (ADCSRA & _BV(ADIE)) == 0)
+	{
+		// the interrupt stopped itself when the last channel was disabled
+		startChannel(toChannel(p_pin));
+	}
+	SREG = oldSREG;
+}
+
+
+void disable(uint8_t p_pin)
+{
+	RC_TRACE("disable pin: %u", p_pin);
+	uint8_t mask = _BV(toChannel(p_pin));
+	
+	uint8_t oldSREG = SREG;
+	cli();
+	s_enabled &= ~mask;
+	s_ready &= ~mask;
+	SREG = oldSREG;
+}
+
+
+bool isEnabled(uint8_t p_pin)
+{
+	return (s_enabled & _BV(toChannel(p_pin))) != 0;
+}
+
+
+void start()
+{
+	RC_TRACE("start");
+	uint8_t oldSREG = SREG;
+	cli();
+	s_ready = 0;
+	s_running = true;
+	if (s_enabled != 0)
+	{
+		startChannel(nextChannel(Channels - 1));
+	}
+	SREG = oldSREG;
+}
+
+
+void stop()
+{
+	RC_TRACE("stop");
+	uint8_t oldSREG = SREG;
+	cli();
+	s_running = false;
+	ADCSRA &= ~_BV(ADIE);
+	SREG = oldSREG;
+}
+
+
+bool isRunning()
+{
+	return s_running;
+}
+
+
+bool isReady()
+{
+	return (s_ready & s_enabled) == s_enabled;
+}
+
+
+bool isReady(uint8_t p_pin)
+{
+	return (s_ready & _BV(toChannel(p_pin))) != 0;
+}
+
+
+uint16_t read(uint8_t p_pin)
+{
+	uint8_t channel = toChannel(p_pin);
+	
+	uint8_t oldSREG = SREG;
+	cli();
+	uint16_t value = s_values[channel];
+	SREG = oldSREG;
+	
+	return value;
+}
+
+
+// namespace end
+}
+}
+
+
+// ADC conversion complete handler
+ISR(ADC_vect)
+{
+	using namespace rc::adc;
+	
+	uint16_t sample = ADC;
+	if (s_discard)
+	{
+		s_discard = false;
+	}
+	else
+	{
+		s_sum += sample;
+		if (++s_count == Samples)
+		{
+			// decimate, every 4 conversions summed give one bit more than the ADC has,
+			// a channel disabled during its round keeps its last value and stays not ready
+			if (s_enabled & _BV(s_channel))
+			{
+				s_values[s_channel] = s_sum >> RC_ADC_OVERSAMPLING;
+				s_ready |= _BV(s_channel);
+			}
+			
+			if (s_enabled == 0)
+			{
+				ADCSRA &= ~_BV(ADIE);
+				return;
+			}
+			uint8_t next = nextChannel(s_channel);
+			if (next != s_channel)
+			{
+				startChannel(next);
+				return;
+			}
+			s_count = 0;
+			s_sum   = 0;
+		}
+	}
+	ADCSRA |= _BV(ADSC);
+}
+
+#endif // RC_USE_ADC
@@ -0,0 +1,92 @@
+#ifndef INC_RC_ADC_H
+#define INC_RC_ADC_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_adc.h
+** Free running, oversampling ADC sampler
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+// include global config settings first
+#include <rc_config.h>
+
+
+#ifdef RC_USE_ADC
+
+/*!
+ *  \file      rc_adc.h
+ *  \brief     Free running, oversampling ADC sampler.
+ *  \details   The ADC complete interrupt converts all enabled channels in turn, each channel
+ *             gets 4^RC_ADC_OVERSAMPLING conversions which are summed and decimated into a value
+ *             with RC_ADC_OVERSAMPLING bits more resolution than analogRead. Reading a value
+ *             takes no time at all, where analogRead blocks for about 110 microseconds.
+ *             AIPin reads its pin from the sampler while it's running.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+*/
+
+namespace rc {
+namespace adc {
+
+	/*! \brief Adds an analog pin to the channels being sampled.
+	    \param p_pin Analog pin, [A0 - A7] or [0 - 7].
+	    \note May be called while the sampler is running, the pin is sampled from the next round on.*/
+	void enable(uint8_t p_pin);
+	
+	/*! \brief Removes an analog pin from the channels being sampled.
+	    \param p_pin Analog pin, [A0 - A7] or [0 - 7].
+	    \note The sampler stops by itself once no channels are left.*/
+	void disable(uint8_t p_pin);
+	
+	/*! \brief Checks if an analog pin is being sampled.
+	    \param p_pin Analog pin, [A0 - A7] or [0 - 7].
+	    \return Whether the pin is enabled.*/
+	bool isEnabled(uint8_t p_pin);
+	
+	/*! \brief Starts converting the enabled channels, using AVcc as reference.
+	    \note Call this from setup(), the Arduino core configures the ADC after global objects are constructed.
+	    \warning analogRead can't be used while the sampler is running.*/
+	void start();
+	
+	/*! \brief Stops the sampler.
+	    \note The conversion in progress, if any, completes within 110 microseconds. Wait that long before calling analogRead.*/
+	void stop();
+	
+	/*! \brief Checks if the sampler is running.
+	    \return Whether the sampler is running.*/
+	bool isRunning();
+	
+	/*! \brief Checks if all enabled channels have been sampled at least once since start.
+	    \return Whether every enabled channel has a value.*/
+	bool isReady();
+	
+	/*! \brief Checks if an analog pin has been sampled at least once since start or since it was enabled.
+	    \param p_pin Analog pin, [A0 - A7] or [0 - 7].
+	    \return Whether read returns a value for the pin.*/
+	bool isReady(uint8_t p_pin);
+	
+	/*! \brief Gets the latest value of an analog pin.
+	    \param p_pin Analog pin, [A0 - A7] or [0 - 7].
+	    \return Oversampled value, range [0 - (1023 << RC_ADC_OVERSAMPLING)], 0 if the pin hasn't been sampled yet.*/
+	uint16_t read(uint8_t p_pin);
+	
+} // adc
+} // rc
+
+/** \example adc_example.pde
+ * This is an example of how to use the free running ADC sampler.
+ */
+ 
+#endif // RC_USE_ADC
+
+#endif // INC_RC_ADC_H
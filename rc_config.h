@@ -25,6 +25,17 @@
 // You may set this to any number between 4 and 18
 #define RC_MAX_CHANNELS 18
 
+// Set the maximum number of servos ServoOut drives, it uses the first this many pins of its buffer.
+// Every servo takes 23 bytes of RAM on AVR: its port and pin mask, and two events of 5 bytes
+// in both the frame being sent and the frame being prepared. 18 servos take about 420 bytes,
+// a fifth of an ATmega328, so reduce this to the number of servos you connect.
+// You may set this to any number between 1 and RC_MAX_CHANNELS
+#define RC_SERVOOUT_MAX_SERVOS RC_MAX_CHANNELS
+
+#if RC_SERVOOUT_MAX_SERVOS > RC_MAX_CHANNELS
+	#error RC_SERVOOUT_MAX_SERVOS must not exceed RC_MAX_CHANNELS
+#endif
+
 
 // -------------------------
 // BUZZER / SPEAKER SETTINGS
@@ -54,6 +65,35 @@
 #define RC_USE_EXTINT
 
 
+// Use the built-in UART interrupt handlers of ArduinoRCLib (SBUSIn, SBUSOut, CRSFOut and rc::uart)
+// these can't be used together with Serial, which has its own handlers.
+// With this defined rc::uart sends and receives through ring buffers in its handlers, put and write
+// return right away and drop bytes when the buffer is full, space and available count the buffers.
+// Without it rc::uart polls the uart: put waits for the data register, read only sees the single
+// byte the uart holds, space and available return 0 or 1 and the overflow counters stay 0.
+// Leave this commented out if you want to supply your own handlers,
+// call byteReceived/dataRegisterEmpty of the class from your handlers in that case.
+//#define RC_USE_UART
+
+// Sizes of the transmit and receive buffers of rc::uart (rc_uart.h) when RC_USE_UART is defined,
+// these must be powers of 2, one byte of each buffer is never used.
+#define RC_UART_TX_SIZE 64
+#define RC_UART_RX_SIZE 16
+
+// Use the free running ADC sampler of ArduinoRCLib (rc_adc.h), AIPin reads its pin from the sampler
+// once it's started instead of waiting for analogRead. The sampler owns the ADC interrupt,
+// analogRead can't be used while it's running.
+//#define RC_USE_ADC
+
+// Extra bits of resolution the ADC sampler gets by oversampling, range [0 - 3]. Each value is the sum
+// of 4^n conversions of 104 microseconds each, so 2 gives four pins a new 12 bit value every 7 ms.
+#define RC_ADC_OVERSAMPLING 2
+
+// Number of functions that can be called at every Timer1 overflow next to the one of
+// Timer1::setOverflow, see Timer1::addOverflowHook.
+#define RC_TIMER1_OVERFLOW_HOOKS 2
+
+
 // ------------------
 // DEBUGGING SETTINGS
 // ------------------
@@ -75,4 +115,31 @@
 #define RC_DEBUG_LEVEL RC_GLOBAL_LEVEL
 #endif
 
+// Modules, the debug level of each module of the library can be set in rc_debug_lib.h.
+// Messages of a module are only output while its bit (1 << module) is set in the mask
+// set by rc::setDebugMask, this is the only runtime cost of debugging messages.
+// Your own code is in module RC_MODULE_USER, unless you define RC_MODULE before including rc_debug.h
+#define RC_MODULE_USER   0 // Your own code
+#define RC_MODULE_PPM    1 // PPMIn, PPMOut, SBUSIn, SBUSOut, CRSFOut and Trainer
+#define RC_MODULE_SERVO  2 // ServoIn, ServoOut and PWMOut
+#define RC_MODULE_MIXER  3 // Channel processing, modifiers, mixes and models
+#define RC_MODULE_SWITCH 4 // Switches and their processing
+#define RC_MODULE_IO     5 // Pins, timers, interrupt handlers and sound
+
+// Define RC_BINARY_LOG to have the debug messages stored as binary records in a ring buffer instead
+// of being formatted and printed right away, see rc_log.h. You can change this on a per file basis
+// as well, by defining RC_BINARY_LOG before including rc_debug.h. Failed asserts are always printed.
+//#define RC_BINARY_LOG
+
+// Size of the binary log buffer in bytes, this must be a power of 2 no larger than 256.
+#define RC_LOG_SIZE 128
+
+// Define RC_USE_PROFILER to have RC_PROFILE measure how long stages of your code take, see rc_profiler.h.
+// Without it RC_PROFILE does nothing, so it may be left in your code. You can change this on a per file
+// basis as well, by defining RC_USE_PROFILER before including rc_profiler.h.
+//#define RC_USE_PROFILER
+
+// Number of stages the profiler keeps statistics of, each takes 28 bytes of RAM.
+#define RC_PROFILER_STAGES 6
+
 #endif // INC_RC_CONFIG_H
@@ -20,6 +20,9 @@
 namespace rc
 {
 
+static uint8_t s_debugMask = 0xFF; //!< Modules whose messages are output.
+
+
 void halt(const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt, ...)
 {
 	fprintf_P(stdout, PSTR("ASSERT FAILED at %S:%d: "), p_file, p_line);
@@ -99,6 +102,18 @@ void trace(const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt, ...
 }
 
 
+void setDebugMask(uint8_t p_mask)
+{
+	s_debugMask = p_mask;
+}
+
+
+uint8_t getDebugMask()
+{
+	return s_debugMask;
+}
+
+
 // namespace end
 }
 #endif // RC_GLOBAL_LEVEL > 0
@@ -32,6 +32,29 @@ typedef uint8_t PROGMEM prog_uint8_t;
 #endif
 
 
+// The module this file belongs to, its messages are only output while the module is enabled in the mask
+#ifndef RC_MODULE
+#define RC_MODULE RC_MODULE_USER
+#endif
+#define RC_MODULE_ENABLED ((rc::getDebugMask() & (1 << (RC_MODULE))) != 0)
+
+
+// Select how messages are output, printed right away or stored as binary records
+#ifdef RC_BINARY_LOG
+	#define RC_OUT_ERROR(...) rc::log::write(rc::log::Level_Error, __VA_ARGS__)
+	#define RC_OUT_WARN(...)  rc::log::write(rc::log::Level_Warn,  __VA_ARGS__)
+	#define RC_OUT_INFO(...)  rc::log::write(rc::log::Level_Info,  __VA_ARGS__)
+	#define RC_OUT_DEBUG(...) rc::log::write(rc::log::Level_Debug, __VA_ARGS__)
+	#define RC_OUT_TRACE(...) rc::log::write(rc::log::Level_Trace, __VA_ARGS__)
+#else
+	#define RC_OUT_ERROR rc::error
+	#define RC_OUT_WARN  rc::warn
+	#define RC_OUT_INFO  rc::info
+	#define RC_OUT_DEBUG rc::debug
+	#define RC_OUT_TRACE rc::trace
+#endif
+
+
 // Define Asserts
 #if RC_DEBUG_LEVEL >= 1
 	#define RC_ASSERT(x) \
@@ -50,11 +73,11 @@ typedef uint8_t PROGMEM prog_uint8_t;
 // Define Checks
 #if RC_DEBUG_LEVEL >= 2
 	#define RC_CHECK(x) \
-		do { if (!(x)) { rc::warn(PSTR(__FILE__), __LINE__, PSTR("failed check: %S"), PSTR(#x)); } } while (0)
+		do { if (!(x) && RC_MODULE_ENABLED) { RC_OUT_WARN(PSTR(__FILE__), __LINE__, PSTR("failed check: %S"), PSTR(#x)); } } while (0)
 	#define RC_CHECK_MSG(x, fmt, ...) \
-		do { if (!(x)) { rc::warn(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } } while (0)
+		do { if (!(x) && RC_MODULE_ENABLED) { RC_OUT_WARN(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } } while (0)
 	#define RC_CHECK_MINMAX(x, min, max) \
-		do { if ((x) > (max) || (x) < (min)) { rc::warn(PSTR(__FILE__), __LINE__, \
+		do { if (((x) > (max) || (x) < (min)) && RC_MODULE_ENABLED) { RC_OUT_WARN(PSTR(__FILE__), __LINE__, \
 		PSTR("%S (%d) out of bounds [%d - %d]"), PSTR(#x), (x), (min), (max)); } } while (0)
 #else
 	#define RC_CHECK(x)
@@ -65,7 +88,7 @@ typedef uint8_t PROGMEM prog_uint8_t;
 // Define error printing
 #if RC_DEBUG_LEVEL >= 1
 	#define RC_ERROR(fmt, ...) \
-		do { rc::error(PSTR(__FILE__), __LINE__, PSTR(fmt),  ##__VA_ARGS__); } while (0)
+		do { if (RC_MODULE_ENABLED) { RC_OUT_ERROR(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } } while (0)
 #else
 	#define RC_ERROR(fmt, ...)
 #endif
@@ -73,7 +96,7 @@ typedef uint8_t PROGMEM prog_uint8_t;
 // Define warning printing
 #if RC_DEBUG_LEVEL >= 2
 	#define RC_WARN(fmt, ...) \
-		do { rc::warn(PSTR(__FILE__), __LINE__, PSTR(fmt),  ##__VA_ARGS__); } while (0)
+		do { if (RC_MODULE_ENABLED) { RC_OUT_WARN(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } } while (0)
 #else
 	#define RC_WARN(fmt, ...)
 #endif
@@ -81,7 +104,7 @@ typedef uint8_t PROGMEM prog_uint8_t;
 // Define info printing
 #if RC_DEBUG_LEVEL >= 3
 	#define RC_INFO(fmt, ...) \
-		do { rc::info(PSTR(__FILE__), __LINE__, PSTR(fmt),  ##__VA_ARGS__); } while (0)
+		do { if (RC_MODULE_ENABLED) { RC_OUT_INFO(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } } while (0)
 #else
 	#define RC_INFO(fmt, ...)
 #endif
@@ -89,7 +112,7 @@ typedef uint8_t PROGMEM prog_uint8_t;
 // Define debug printing
 #if RC_DEBUG_LEVEL >= 4
 	#define RC_DEBUG(fmt, ...) \
-		do { rc::debug(PSTR(__FILE__), __LINE__, PSTR(fmt),  ##__VA_ARGS__); } while (0)
+		do { if (RC_MODULE_ENABLED) { RC_OUT_DEBUG(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } } while (0)
 #else
 	#define RC_DEBUG(fmt, ...)
 #endif
@@ -97,7 +120,7 @@ typedef uint8_t PROGMEM prog_uint8_t;
 // Define trace printing
 #if RC_DEBUG_LEVEL >= 5
 	#define RC_TRACE(fmt, ...) \
-		do { rc::trace(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } while (0)
+		do { if (RC_MODULE_ENABLED) { RC_OUT_TRACE(PSTR(__FILE__), __LINE__, PSTR(fmt), ##__VA_ARGS__); } } while (0)
 #else
 	#define RC_TRACE(fmt, ...)
 #endif
@@ -113,11 +136,25 @@ namespace rc
 	void info(const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt, ...);
 	void debug(const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt, ...);
 	void trace(const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt, ...);
+	
+	/*! \brief Sets which modules output debug messages
+	    \param p_mask Bit mask, bit (1 << RC_MODULE_x) enables module RC_MODULE_x. All modules are enabled by default.
+	    \note Asserts are never masked.*/
+	void setDebugMask(uint8_t p_mask);
+	
+	/*! \brief Gets which modules output debug messages
+	    \return Bit mask of the enabled modules.*/
+	uint8_t getDebugMask();
 }
 #endif
 /** \example debug_example.pde
  * This is an example of how to use the debug functions.
  */
 
+// the binary log functions
+#ifdef RC_BINARY_LOG
+#include <rc_log.h>
+#endif
+
 
 #endif // INC_RC_DEBUG_H
@@ -24,12 +24,35 @@
 // 4 = DEBUG - Debugging messages enabled
 // 5 = TRACE - Trace messages enabled
 
+// These are the debug levels of the modules of the library, see rc_config.h for what's in them.
+// Raise the level of just the module you're interested in, the others won't take any space or time.
+#define RC_LIB_LEVEL_PPM    RC_LIB_LEVEL
+#define RC_LIB_LEVEL_SERVO  RC_LIB_LEVEL
+#define RC_LIB_LEVEL_MIXER  RC_LIB_LEVEL
+#define RC_LIB_LEVEL_SWITCH RC_LIB_LEVEL
+#define RC_LIB_LEVEL_IO     RC_LIB_LEVEL
+
 #include <rc_config.h>
 
-// check if debugging is enabled, if so, overrule the debug level
+// check if debugging is enabled, if so, overrule the debug level with the level of the module
+// the source file defined as RC_MODULE before including this file
 #if RC_GLOBAL_LEVEL > 0
 #undef RC_DEBUG_LEVEL
-#define RC_DEBUG_LEVEL RC_LIB_LEVEL
+#if !defined(RC_MODULE)
+	#define RC_DEBUG_LEVEL RC_LIB_LEVEL
+#elif RC_MODULE == RC_MODULE_PPM
+	#define RC_DEBUG_LEVEL RC_LIB_LEVEL_PPM
+#elif RC_MODULE == RC_MODULE_SERVO
+	#define RC_DEBUG_LEVEL RC_LIB_LEVEL_SERVO
+#elif RC_MODULE == RC_MODULE_MIXER
+	#define RC_DEBUG_LEVEL RC_LIB_LEVEL_MIXER
+#elif RC_MODULE == RC_MODULE_SWITCH
+	#define RC_DEBUG_LEVEL RC_LIB_LEVEL_SWITCH
+#elif RC_MODULE == RC_MODULE_IO
+	#define RC_DEBUG_LEVEL RC_LIB_LEVEL_IO
+#else
+	#error Unknown RC_MODULE
+#endif
 #endif
 
 // include the actual debug header
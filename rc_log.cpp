@@ -0,0 +1,150 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_log.cpp
+** Deferred binary logging
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <rc_log.h>
+#include <rc_uart.h>
+#include <util.h>
+
+
+#if RC_GLOBAL_LEVEL > 0
+
+#if RC_LOG_SIZE > 256 || (RC_LOG_SIZE & (RC_LOG_SIZE - 1)) != 0
+	#error RC_LOG_SIZE must be a power of 2 no larger than 256
+#endif
+
+namespace rc {
+namespace log {
+
+enum
+{
+	Mask       = RC_LOG_SIZE - 1,
+	HeaderSize = 5 + 2 * sizeof(const prog_char*)
+};
+
+// Records may be written from interrupt handlers as well as from the main code, so a record
+// is copied into the buffer with interrupts disabled. Only read and send move the tail.
+static uint8_t           s_buffer[RC_LOG_SIZE]; //!< Records waiting to be read.
+static volatile uint8_t  s_head = 0;            //!< Next free slot, moved by record.
+static volatile uint8_t  s_tail = 0;            //!< Next byte to read, moved by read and send.
+static volatile uint16_t s_dropped = 0;         //!< Records that didn't fit.
+
+
+// Public functions
+
+void record(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+            const uint8_t* p_args, uint8_t p_size)
+{
+	uint8_t header[HeaderSize];
+	header[0] = Sync;
+	header[1] = p_level;
+	header[2] = p_size;
+	header[3] = p_line & 0xFF;
+	header[4] = p_line >> 8;
+	memcpy(header + 5, &p_file, sizeof(p_file));
+	memcpy(header + 5 + sizeof(p_file), &p_fmt, sizeof(p_fmt));
+	
+	uint8_t oldSREG = SREG;
+	cli();
+	
+	uint8_t head = s_head;
+	uint8_t space = (s_tail - head - 1) & Mask;
+	if (HeaderSize + p_size > space)
+	{
+		++s_dropped;
+		SREG = oldSREG;
+		return;
+	}
+	
+	for (uint8_t i = 0; i < HeaderSize; ++i)
+	{
+		s_buffer[head] = header[i];
+		head = (head + 1) & Mask;
+	}
+	for (uint8_t i = 0; i < p_size; ++i)
+	{
+		s_buffer[head] = p_args[i];
+		head = (head + 1) & Mask;
+	}
+	memoryBarrier(); // store the record before publishing it
+	s_head = head;
+	
+	SREG = oldSREG;
+}
+
+
+uint8_t read(uint8_t* p_dest, uint8_t p_size)
+{
+	uint8_t tail = s_tail;
+	uint8_t head = s_head;
+	memoryBarrier(); // don't read the bytes before the head
+	
+	uint8_t count = 0;
+	while (tail != head && count < p_size)
+	{
+		p_dest[count] = s_buffer[tail];
+		tail = (tail + 1) & Mask;
+		++count;
+	}
+	s_tail = tail;
+	return count;
+}
+
+
+void send()
+{
+	uint8_t tail = s_tail;
+	uint8_t head = s_head;
+	memoryBarrier(); // don't read the bytes before the head
+	
+	for (uint8_t space = uart::space(); tail != head && space > 0; --space)
+	{
+		uart::put(s_buffer[tail]);
+		tail = (tail + 1) & Mask;
+	}
+	s_tail = tail;
+}
+
+
+uint8_t available()
+{
+	return (s_head - s_tail) & Mask;
+}
+
+
+uint16_t getDropped()
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	uint16_t dropped = s_dropped;
+	SREG = oldSREG;
+	return dropped;
+}
+
+
+void clear()
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	s_tail = s_head;
+	s_dropped = 0;
+	SREG = oldSREG;
+}
+
+
+// namespace end
+}
+}
+
+#endif // RC_GLOBAL_LEVEL > 0
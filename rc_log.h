@@ -0,0 +1,198 @@
+#ifndef INC_RC_LOG_H
+#define INC_RC_LOG_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_log.h
+** Deferred binary logging
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+#include <string.h>
+
+// for prog_char and the global config settings
+#include <rc_debug.h>
+
+
+#if RC_GLOBAL_LEVEL > 0
+
+/*!
+ *  \file      rc_log.h
+ *  \brief     Deferred binary logging.
+ *  \details   With RC_BINARY_LOG defined the debug macros of rc_debug.h don't format their
+ *             messages, they store a record in a ring buffer instead. That takes a few
+ *             microseconds, so the macros may be used in interrupt handlers as well.
+ *             Send the buffer to a PC with send() and format the records there with
+ *             tools/rc_logdecode.py, which reads the strings from the elf file of the build.
+ *
+ *             A record consists of, in little endian:
+ *             - Sync (0xA5)
+ *             - level, 1 (error) to 5 (trace)
+ *             - number of argument bytes
+ *             - line number, 2 bytes
+ *             - address of the file name in program space
+ *             - address of the format string in program space
+ *             - the arguments, with the same promotions as arguments of printf
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+*/
+
+namespace rc {
+namespace log {
+
+	enum
+	{
+		Sync = 0xA5 //!< First byte of every record.
+	};
+	
+	/*! \brief Level of a record, matches the debug levels.*/
+	enum Level
+	{
+		Level_Error = 1, //!< RC_ERROR and RC_ASSERT
+		Level_Warn,      //!< RC_WARN and RC_CHECK
+		Level_Info,      //!< RC_INFO
+		Level_Debug,     //!< RC_DEBUG
+		Level_Trace      //!< RC_TRACE
+	};
+	
+	/*! \brief Type an argument is stored as, small integers are promoted to int like printf arguments.*/
+	template<typename T> struct Arg                 { typedef T            Type; };
+	template<>           struct Arg<bool>           { typedef int          Type; };
+	template<>           struct Arg<char>           { typedef int          Type; };
+	template<>           struct Arg<signed char>    { typedef int          Type; };
+	template<>           struct Arg<unsigned char>  { typedef int          Type; };
+	template<>           struct Arg<short>          { typedef int          Type; };
+	template<>           struct Arg<unsigned short> { typedef unsigned int Type; };
+	template<>           struct Arg<float>          { typedef double       Type; };
+	
+	/*! \brief Stores a record in the log buffer
+	    \param p_level Level of the record.
+	    \param p_file File name in program space.
+	    \param p_line Line number.
+	    \param p_fmt Format string in program space.
+	    \param p_args Arguments.
+	    \param p_size Number of argument bytes.
+	    \note The record is dropped if it doesn't fit in the buffer.*/
+	void record(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+	            const uint8_t* p_args, uint8_t p_size);
+	
+	/*! \brief Reads bytes from the log buffer
+	    \param p_dest Destination buffer.
+	    \param p_size Size of the destination buffer.
+	    \return Number of bytes read, records may be split over several reads.*/
+	uint8_t read(uint8_t* p_dest, uint8_t p_size);
+	
+	/*! \brief Moves as much of the log buffer to rc::uart as fits in its transmit buffer.
+	    \note Call from your loop, rc::uart::init must have been called first.*/
+	void send();
+	
+	/*! \brief Gets the number of bytes in the log buffer
+	    \return Number of bytes waiting to be read.*/
+	uint8_t available();
+	
+	/*! \brief Gets the number of records dropped because the log buffer was full
+	    \return Number of records since the last clear, wraps around after 65535.*/
+	uint16_t getDropped();
+	
+	/*! \brief Empties the log buffer and resets the dropped counter.*/
+	void clear();
+	
+	
+	/*! \brief Stores an argument
+	    \param p_dest Where to store it.
+	    \param p_value Argument.
+	    \return Position of the next argument.*/
+	template<typename T>
+	inline uint8_t* pack(uint8_t* p_dest, T p_value)
+	{
+		typename Arg<T>::Type value = p_value;
+		memcpy(p_dest, &value, sizeof(value));
+		return p_dest + sizeof(value);
+	}
+	
+	
+	// The debug macros call write, one overload per number of arguments
+	
+	inline void write(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt)
+	{
+		record(p_level, p_file, p_line, p_fmt, 0, 0);
+	}
+	
+	template<typename A>
+	inline void write(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+	                  A p_a)
+	{
+		uint8_t args[sizeof(typename Arg<A>::Type)];
+		pack(args, p_a);
+		record(p_level, p_file, p_line, p_fmt, args, sizeof(args));
+	}
+	
+	template<typename A, typename B>
+	inline void write(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+	                  A p_a, B p_b)
+	{
+		uint8_t args[sizeof(typename Arg<A>::Type) + sizeof(typename Arg<B>::Type)];
+		pack(pack(args, p_a), p_b);
+		record(p_level, p_file, p_line, p_fmt, args, sizeof(args));
+	}
+	
+	template<typename A, typename B, typename C>
+	inline void write(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+	                  A p_a, B p_b, C p_c)
+	{
+		uint8_t args[sizeof(typename Arg<A>::Type) + sizeof(typename Arg<B>::Type) +
+		             sizeof(typename Arg<C>::Type)];
+		pack(pack(pack(args, p_a), p_b), p_c);
+		record(p_level, p_file, p_line, p_fmt, args, sizeof(args));
+	}
+	
+	template<typename A, typename B, typename C, typename D>
+	inline void write(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+	                  A p_a, B p_b, C p_c, D p_d)
+	{
+		uint8_t args[sizeof(typename Arg<A>::Type) + sizeof(typename Arg<B>::Type) +
+		             sizeof(typename Arg<C>::Type) + sizeof(typename Arg<D>::Type)];
+		pack(pack(pack(pack(args, p_a), p_b), p_c), p_d);
+		record(p_level, p_file, p_line, p_fmt, args, sizeof(args));
+	}
+	
+	template<typename A, typename B, typename C, typename D, typename E>
+	inline void write(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+	                  A p_a, B p_b, C p_c, D p_d, E p_e)
+	{
+		uint8_t args[sizeof(typename Arg<A>::Type) + sizeof(typename Arg<B>::Type) +
+		             sizeof(typename Arg<C>::Type) + sizeof(typename Arg<D>::Type) +
+		             sizeof(typename Arg<E>::Type)];
+		pack(pack(pack(pack(pack(args, p_a), p_b), p_c), p_d), p_e);
+		record(p_level, p_file, p_line, p_fmt, args, sizeof(args));
+	}
+	
+	template<typename A, typename B, typename C, typename D, typename E, typename F>
+	inline void write(uint8_t p_level, const prog_char* p_file, uint16_t p_line, const prog_char* p_fmt,
+	                  A p_a, B p_b, C p_c, D p_d, E p_e, F p_f)
+	{
+		uint8_t args[sizeof(typename Arg<A>::Type) + sizeof(typename Arg<B>::Type) +
+		             sizeof(typename Arg<C>::Type) + sizeof(typename Arg<D>::Type) +
+		             sizeof(typename Arg<E>::Type) + sizeof(typename Arg<F>::Type)];
+		pack(pack(pack(pack(pack(pack(args, p_a), p_b), p_c), p_d), p_e), p_f);
+		record(p_level, p_file, p_line, p_fmt, args, sizeof(args));
+	}
+	
+// namespace end
+}
+}
+/** \example log_example.pde
+ * This is an example of how to use the deferred binary log.
+ */
+
+#endif // RC_GLOBAL_LEVEL > 0
+
+#endif // INC_RC_LOG_H
@@ -12,7 +12,9 @@
 ** -------------------------------------------------------------------------*/
 
 #include <Arduino.h>
+#include <avr/pgmspace.h>
 
+#define RC_MODULE RC_MODULE_IO
 #include <rc_debug_lib.h>
 #include <rc_pcint.h>
 
@@ -32,27 +34,43 @@ enum
 static uint8_t  s_lastB = 0; //!< last read value of PINB
 static Callback s_callB[BPins] = { 0 }; //!< Callback functions for port B
 static void*    s_userB[BPins] = { 0 }; //!< User data for port B
+static uint8_t  s_argB[BPins]  = { 0 }; //!< First callback argument for port B
 
 static uint8_t  s_lastC = 0; //!< last read value of PINC
 static Callback s_callC[CPins] = { 0 }; //!< Callback functions for port C
 static void*    s_userC[CPins] = { 0 }; //!< User data for port C
+static uint8_t  s_argC[CPins]  = { 0 }; //!< First callback argument for port C
 
 static uint8_t  s_lastD = 0; //!< last read value of PIND
 static Callback s_callD[DPins] = { 0 }; //!< Callback functions for port D
 static void*    s_userD[DPins] = { 0 }; //!< User data for port D
+static uint8_t  s_argD[DPins]  = { 0 }; //!< First callback argument for port D
+
+//! Index of the lowest set bit of a nibble, the AVR has no instruction for it
+static const uint8_t s_lowestBit[16] PROGMEM = { 0, 0, 1, 0, 2, 0, 1, 0, 3, 0, 1, 0, 2, 0, 1, 0 };
 
 
 void enable(uint8_t p_pin, Callback p_callback, void* p_user)
+{
+	enable(p_pin, p_callback, p_user, p_pin);
+}
+
+
+void enable(uint8_t p_pin, Callback p_callback, void* p_user, uint8_t p_index)
 {
 	pinMode(p_pin, INPUT);
 	
 	uint8_t bit = digitalPinToPCMSKbit(p_pin);
 	uint8_t port = digitalPinToPort(p_pin);
 	
+	// don't let the interrupt handler see a half written entry
+	uint8_t oldSREG = SREG;
+	cli();
 	if (port == 2)
 	{
 		s_callB[bit]  = p_callback;
 		s_userB[bit]  = p_user;
+		s_argB[bit]   = p_index;
 		PCMSK0       |= _BV(bit);
 		PCICR        |= _BV(0);
 	}
@@ -60,6 +78,7 @@ void enable(uint8_t p_pin, Callback p_callback, void* p_user)
 	{
 		s_callC[bit]  = p_callback;
 		s_userC[bit]  = p_user;
+		s_argC[bit]   = p_index;
 		PCMSK1       |= _BV(bit);
 		PCICR        |= _BV(1);
 	}
@@ -67,9 +86,11 @@ void enable(uint8_t p_pin, Callback p_callback, void* p_user)
 	{
 		s_callD[bit]  = p_callback;
 		s_userD[bit]  = p_user;
+		s_argD[bit]   = p_index;
 		PCMSK2       |= _BV(bit);
 		PCICR        |= _BV(2);
 	}
+	SREG = oldSREG;
 }
 
 
@@ -88,6 +109,7 @@ void disable(uint8_t p_pin)
 		
 		s_callB[bit] = 0;
 		s_userB[bit] = 0;
+		s_argB[bit]  = 0;
 	}
 	else if (port == 3)
 	{
@@ -99,6 +121,7 @@ void disable(uint8_t p_pin)
 		
 		s_callC[bit] = 0;
 		s_userC[bit] = 0;
+		s_argC[bit]  = 0;
 	}
 	else if (port == 4)
 	{
@@ -110,6 +133,31 @@ void disable(uint8_t p_pin)
 		
 		s_callD[bit] = 0;
 		s_userD[bit] = 0;
+		s_argD[bit]  = 0;
+	}
+}
+
+
+/*! \brief Calls the callbacks of changed pins, visits only the bits that changed.
+    \param p_change Changed pins with an active change interrupt.
+    \param p_level Current level of the port.
+    \param p_call Callback functions of the port.
+    \param p_user User data of the port.
+    \param p_arg First callback arguments of the port.*/
+static inline void dispatch(uint8_t p_change, uint8_t p_level,
+                            Callback* p_call, void** p_user, uint8_t* p_arg)
+{
+	while (p_change != 0)
+	{
+		uint8_t i = (p_change & 0x0F) != 0 ?
+		            pgm_read_byte(s_lowestBit + (p_change & 0x0F)) :
+		            pgm_read_byte(s_lowestBit + (p_change >> 4)) + 4;
+		p_change &= p_change - 1; // clear lowest set bit
+		
+		if (p_call[i] != 0)
+		{
+			p_call[i](p_arg[i], p_level & _BV(i), p_user[i]);
+		}
 	}
 }
 
@@ -125,14 +173,7 @@ ISR(PCINT0_vect)
 	uint8_t change = (newB ^ rc::pcint::s_lastB) & PCMSK0; // only show changed pins with active change interrupt
 	rc::pcint::s_lastB = newB;
 	
-	for (uint8_t i = 0; i < rc::pcint::BPins; ++i)
-	{
-		if (change & 1 && rc::pcint::s_callB[i] != 0)
-		{
-			rc::pcint::s_callB[i](i + 8, rc::pcint::s_lastB & _BV(i), rc::pcint::s_userB[i]);
-		}
-		change >>= 1;
-	}
+	rc::pcint::dispatch(change, newB, rc::pcint::s_callB, rc::pcint::s_userB, rc::pcint::s_argB);
 }
 
 // Pin change 1 (port C) interrupt
@@ -142,14 +183,7 @@ ISR(PCINT1_vect)
 	uint8_t change = (newC ^ rc::pcint::s_lastC) & PCMSK1; // only show changed pins with active change interrupt
 	rc::pcint::s_lastC = newC;
 	
-	for (uint8_t i = 0; i < rc::pcint::CPins; ++i)
-	{
-		if (change & 1 && rc::pcint::s_callC[i] != 0)
-		{
-			rc::pcint::s_callC[i](i + 14, rc::pcint::s_lastC & _BV(i), rc::pcint::s_userC[i]);
-		}
-		change >>= 1;
-	}
+	rc::pcint::dispatch(change, newC, rc::pcint::s_callC, rc::pcint::s_userC, rc::pcint::s_argC);
 }
 
 // Pin change 2 (port D) interrupt
@@ -159,14 +193,7 @@ ISR(PCINT2_vect)
 	uint8_t change = (newD ^ rc::pcint::s_lastD) & PCMSK2; // only show changed pins with active change interrupt
 	rc::pcint::s_lastD = newD;
 	
-	for (uint8_t i = 0; i < rc::pcint::DPins; ++i)
-	{
-		if ((change & 1) && rc::pcint::s_callD[i] != 0)
-		{
-			rc::pcint::s_callD[i](i, rc::pcint::s_lastD & _BV(i), rc::pcint::s_userD[i]);
-		}
-		change >>= 1;
-	}
+	rc::pcint::dispatch(change, newD, rc::pcint::s_callD, rc::pcint::s_userD, rc::pcint::s_argD);
 }
 
 
@@ -45,6 +45,14 @@ namespace pcint {
 	    \param p_user User supplied data.*/
 	void enable(uint8_t p_pin, Callback p_callback, void* p_user = 0);
 	
+	/*! \brief Enable pin change interrupt and sets handler, the callback gets an index instead of the pin.
+	    \param p_pin Hardware pin to enable pin change interrupt for.
+	    \param p_callback Function to call on interrupt, called with p_index as first parameter.
+	    \param p_user User supplied data.
+	    \param p_index Value to pass to the callback, like the index of the pin in a list.
+	    \note Saves the callback from looking up the pin when it handles multiple pins.*/
+	void enable(uint8_t p_pin, Callback p_callback, void* p_user, uint8_t p_index);
+	
 	/*! \brief Disables pin change interrupt.
 	    \param p_pin Hardware pin to disable change interrupts for.*/
 	void disable(uint8_t p_pin);
@@ -0,0 +1,141 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_profiler.cpp
+** Measures how long stages of the main loop take
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <stdio.h>
+
+#include <Arduino.h>
+
+#define RC_MODULE RC_MODULE_IO
+#include <rc_debug_lib.h>
+#include <rc_profiler.h>
+
+
+namespace rc {
+namespace profiler {
+
+static Stage s_stages[RC_PROFILER_STAGES]; //!< Statistics of all stages.
+
+
+static void clear(Stage& p_stage)
+{
+	p_stage.count = 0;
+	p_stage.min   = 0;
+	p_stage.max   = 0;
+	p_stage.total = 0;
+	for (uint8_t i = 0; i < Bins; ++i)
+	{
+		p_stage.histogram[i] = 0;
+	}
+}
+
+
+// Public functions
+
+void setName(uint8_t p_stage, const prog_char* p_name)
+{
+	RC_ASSERT(p_stage < RC_PROFILER_STAGES);
+	s_stages[p_stage].name = p_name;
+}
+
+
+uint16_t begin()
+{
+	// TCNT1 is read through a temporary register shared with the interrupt routines
+	uint8_t oldSREG = SREG;
+	cli();
+	uint16_t cnt = TCNT1;
+	SREG = oldSREG;
+	return cnt;
+}
+
+
+void end(uint8_t p_stage, uint16_t p_begin)
+{
+	uint16_t ticks = begin() - p_begin;
+	
+	RC_ASSERT(p_stage < RC_PROFILER_STAGES);
+	Stage& stage = s_stages[p_stage];
+	if (stage.count == 0xFFFF)
+	{
+		return;
+	}
+	if (stage.count == 0 || ticks < stage.min)
+	{
+		stage.min = ticks;
+	}
+	++stage.count;
+	stage.total += ticks;
+	if (ticks > stage.max)
+	{
+		stage.max = ticks;
+	}
+	
+	// the first bin is 16 microseconds wide, every next bin twice as wide as the one before
+	uint8_t bin = 0;
+	for (uint16_t rest = ticks >> 5; rest != 0 && bin < Bins - 1; rest >>= 1)
+	{
+		++bin;
+	}
+	++stage.histogram[bin];
+}
+
+
+const Stage& getStage(uint8_t p_stage)
+{
+	RC_ASSERT(p_stage < RC_PROFILER_STAGES);
+	return s_stages[p_stage];
+}
+
+
+void reset()
+{
+	for (uint8_t i = 0; i < RC_PROFILER_STAGES; ++i)
+	{
+		clear(s_stages[i]);
+	}
+}
+
+
+void dump()
+{
+	printf_P(PSTR("stage    runs   min   avg   max |  <16  <32  <64 <128 <256 <512  <1k  >1k us\n"));
+	for (uint8_t i = 0; i < RC_PROFILER_STAGES; ++i)
+	{
+		const Stage& stage = s_stages[i];
+		if (stage.count == 0)
+		{
+			continue;
+		}
+		
+		if (stage.name != 0)
+		{
+			printf_P(PSTR("%-8S"), stage.name);
+		}
+		else
+		{
+			printf_P(PSTR("%-8u"), i);
+		}
+		printf_P(PSTR("%5u %5u %5u %5u |"), stage.count, stage.min >> 1,
+		         static_cast<uint16_t>((stage.total / stage.count) >> 1), stage.max >> 1);
+		for (uint8_t bin = 0; bin < Bins; ++bin)
+		{
+			printf_P(PSTR(" %4u"), stage.histogram[bin]);
+		}
+		printf_P(PSTR("\n"));
+	}
+}
+
+
+// namespace end
+}
+}
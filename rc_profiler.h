@@ -0,0 +1,117 @@
+#ifndef INC_RC_PROFILER_H
+#define INC_RC_PROFILER_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_profiler.h
+** Measures how long stages of the main loop take
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+#include <avr/pgmspace.h>
+
+// include global config settings first
+#include <rc_config.h>
+
+
+/*!
+ *  \file      rc_profiler.h
+ *  \brief     Measures how long stages of the main loop take.
+ *  \details   Stages are timed with Timer1, which must be running, in ticks of half a microsecond.
+ *             For each stage the number of runs, the shortest, average and longest time are kept,
+ *             as well as a histogram with bins of doubling width:
+ *             0-16, 16-32, 32-64, ... microseconds, the last bin holds everything longer.
+ *             Use RC_PROFILE(stage) at the start of a block to time the rest of the block,
+ *             it does nothing unless RC_USE_PROFILER is defined.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+*/
+
+#ifdef RC_USE_PROFILER
+	#define RC_PROFILE_CONCAT2(a, b) a##b
+	#define RC_PROFILE_CONCAT(a, b) RC_PROFILE_CONCAT2(a, b)
+	#define RC_PROFILE(stage) rc::profiler::Scope RC_PROFILE_CONCAT(rc_profile_, __LINE__)(stage)
+#else
+	#define RC_PROFILE(stage)
+#endif
+
+
+namespace rc {
+namespace profiler {
+
+	enum
+	{
+		Bins = 8 //!< Number of histogram bins.
+	};
+	
+	/*! \brief Statistics of a stage, times in Timer1 ticks.*/
+	struct Stage
+	{
+		const prog_char* name;       //!< Name of the stage in program space, 0 if not set.
+		uint16_t    count;           //!< Number of runs, stops at 65535.
+		uint16_t    min;             //!< Shortest run.
+		uint16_t    max;             //!< Longest run.
+		uint32_t    total;           //!< Sum of all runs.
+		uint16_t    histogram[Bins]; //!< Number of runs per bin, stops at 65535.
+	};
+	
+	/*! \brief Sets the name of a stage.
+	    \param p_stage Stage, range [0 - RC_PROFILER_STAGES - 1].
+	    \param p_name Name of the stage in program space, use PSTR.*/
+	void setName(uint8_t p_stage, const prog_char* p_name);
+	
+	/*! \brief Gets the current Timer1 count, the start of a run.
+	    \return Timer1 count.*/
+	uint16_t begin();
+	
+	/*! \brief Adds a run to the statistics of a stage.
+	    \param p_stage Stage, range [0 - RC_PROFILER_STAGES - 1].
+	    \param p_begin Timer1 count at the start of the run, as returned by begin().
+	    \note Runs must take less than 32 milliseconds, the time Timer1 takes to wrap around.*/
+	void end(uint8_t p_stage, uint16_t p_begin);
+	
+	/*! \brief Gets the statistics of a stage.
+	    \param p_stage Stage, range [0 - RC_PROFILER_STAGES - 1].
+	    \return Statistics of the stage.*/
+	const Stage& getStage(uint8_t p_stage);
+	
+	/*! \brief Clears the statistics of all stages, keeps their names.*/
+	void reset();
+	
+	/*! \brief Prints the statistics of all stages that have run, in microseconds, to stdout.
+	    \note Use rc::uart::setStdOut to send them over the uart.*/
+	void dump();
+	
+	
+	/*! \brief Times its own lifetime, as used by RC_PROFILE.*/
+	class Scope
+	{
+	public:
+		/*! \brief Starts a run.
+		    \param p_stage Stage to add the run to.*/
+		Scope(uint8_t p_stage) : m_stage(p_stage), m_begin(begin()) { }
+		
+		/*! \brief Ends the run.*/
+		~Scope() { end(m_stage, m_begin); }
+		
+	private:
+		uint8_t  m_stage; //!< Stage to add the run to.
+		uint16_t m_begin; //!< Timer1 count at the start of the run.
+	};
+	
+// namespace end
+}
+}
+/** \example profiler_example.pde
+ * This is an example of how to use the profiler.
+ */
+
+#endif // INC_RC_PROFILER_H
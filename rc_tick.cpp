@@ -0,0 +1,79 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_tick.cpp
+** Frame time, sampled once per loop for all time based processing
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#include <rc_tick.h>
+
+
+namespace rc {
+namespace tick {
+
+static bool     s_sampled = false; //!< Whether update() has been called
+static uint32_t s_micros  = 0;     //!< Time of the current frame in microseconds
+static uint16_t s_millis  = 0;     //!< Time of the current frame in milliseconds
+static uint32_t s_rest    = 0;     //!< Microseconds not yet counted in s_millis
+static uint16_t s_delta   = 0;     //!< Time between the previous frame and the current one
+
+
+void update()
+{
+	uint32_t now = micros();
+	if (s_sampled == false)
+	{
+		// start counting from where millis() is, so times taken before the first update stay valid
+		s_sampled = true;
+		s_micros  = now;
+		s_millis  = static_cast<uint16_t>(millis());
+		return;
+	}
+	
+	uint32_t delta = now - s_micros;
+	s_micros = now;
+	s_delta  = delta > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(delta);
+	
+	// a frame takes a few milliseconds, subtracting them is cheaper than a 32 bit division
+	s_rest += delta;
+	if (s_rest >= 0x10000)
+	{
+		s_millis += static_cast<uint16_t>(s_rest / 1000);
+		s_rest   %= 1000;
+	}
+	while (s_rest >= 1000)
+	{
+		s_rest -= 1000;
+		++s_millis;
+	}
+}
+
+
+uint16_t getMillis()
+{
+	return s_sampled ? s_millis : static_cast<uint16_t>(millis());
+}
+
+
+uint32_t getMicros()
+{
+	return s_sampled ? s_micros : micros();
+}
+
+
+uint16_t getDelta()
+{
+	return s_delta;
+}
+
+// namespace end
+}
+}
@@ -0,0 +1,63 @@
+#ifndef INC_RC_TICK_H
+#define INC_RC_TICK_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_tick.h
+** Frame time, sampled once per loop for all time based processing
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+
+/*!
+ *  \file      rc_tick.h
+ *  \brief     Frame time, sampled once per loop for all time based processing.
+ *  \details   Channel speed, Retracts, FlightTimer, AnalogSwitch, FlycamOne and AIPinCalibrator
+ *             all take the current time from here. Call update() once at the start of every loop.
+ *             Everything processed in that loop then sees the same time, and micros() is only
+ *             called once instead of every object calling millis(), which disables interrupts
+ *             each time. The getters are plain reads of the sampled time.
+ *             Until update() is called for the first time the functions return the live time,
+ *             so sketches which don't call it keep working.
+ *  \warning   Once update() has been called it has to be called every loop, the time stands still
+ *             in between. The failsafe timeouts of PPMIn and SBUSIn read millis() themselves,
+ *             so losing the signal is detected either way.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+*/
+
+namespace rc {
+namespace tick {
+
+	/*! \brief Samples the time for a new frame, call this once at the start of every loop.*/
+	void update();
+	
+	/*! \brief Gets the time of the current frame.
+	    \return Time in milliseconds, wraps after 65.5 seconds.*/
+	uint16_t getMillis();
+	
+	/*! \brief Gets the time of the current frame.
+	    \return Time in microseconds, wraps after 71 minutes.*/
+	uint32_t getMicros();
+	
+	/*! \brief Gets the time between the previous frame and the current one.
+	    \return Time in microseconds, at most 0xFFFF, 0 until update() has been called twice.*/
+	uint16_t getDelta();
+	
+} // tick
+} // rc
+
+/** \example tick_example.pde
+ * This is an example of how to use the frame time.
+ */
+
+#endif // INC_RC_TICK_H
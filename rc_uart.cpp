@@ -14,6 +14,8 @@
 #include <Arduino.h>
 
 #include <rc_uart.h>
+#include <rc_uartint.h>
+#include <util.h>
 
 
 namespace rc
@@ -21,11 +23,82 @@ namespace rc
 namespace uart
 {
 
+#ifdef _FDEV_SETUP_WRITE
 static FILE s_stdout;
 static FILE s_stdin;
+#endif
 
+#ifdef RC_USE_UART
 
-void init(uint16_t p_baud)
+enum
+{
+	TxMask = RC_UART_TX_SIZE - 1,
+	RxMask = RC_UART_RX_SIZE - 1
+};
+
+// The buffers are single producer, single consumer; put and read only move the head
+// and tail they own, so no interrupts need to be disabled to move data.
+static uint8_t           s_txBuffer[RC_UART_TX_SIZE]; //!< Bytes waiting to be sent.
+static volatile uint8_t  s_txHead = 0;                //!< Next free slot, moved by put.
+static volatile uint8_t  s_txTail = 0;                //!< Next byte to send, moved by the interrupt handler.
+static uint8_t           s_rxBuffer[RC_UART_RX_SIZE]; //!< Bytes waiting to be read.
+static volatile uint8_t  s_rxHead = 0;                //!< Next free slot, moved by the interrupt handler.
+static volatile uint8_t  s_rxTail = 0;                //!< Next byte to read, moved by read.
+static uint16_t          s_txOverflows = 0;           //!< Bytes dropped by put.
+static volatile uint16_t s_rxOverflows = 0;           //!< Bytes dropped by the interrupt handler, buffer full.
+static volatile uint16_t s_rxErrors = 0;              //!< Bytes dropped by the interrupt handler, bad byte.
+
+
+static void dataRegisterEmpty(void* /*p_user*/)
+{
+	uint8_t tail = s_txTail;
+	if (tail != s_txHead)
+	{
+		UDR0 = s_txBuffer[tail];
+		s_txTail = (tail + 1) & TxMask;
+	}
+	else
+	{
+		// nothing left, put enables the interrupt again
+		UCSR0B &= ~_BV(UDRIE0);
+	}
+}
+
+
+static void byteReceived(uint8_t p_byte, bool p_valid, void* /*p_user*/)
+{
+	if (p_valid == false)
+	{
+		++s_rxErrors;
+		return;
+	}
+	
+	uint8_t head = s_rxHead;
+	uint8_t next = (head + 1) & RxMask;
+	if (next == s_rxTail)
+	{
+		++s_rxOverflows;
+		return;
+	}
+	s_rxBuffer[head] = p_byte;
+	memoryBarrier(); // store the byte before publishing it
+	s_rxHead = next;
+}
+
+
+static uint16_t readCounter(volatile uint16_t& p_counter)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	uint16_t value = p_counter;
+	SREG = oldSREG;
+	return value;
+}
+
+#endif // RC_USE_UART
+
+
+void init(uint32_t p_baud)
 {
 	uint16_t ubrr = ((F_CPU / 8) / p_baud) - 1;
 	if (ubrr > 4095)
@@ -40,27 +113,173 @@ void init(uint16_t p_baud)
 
 	UBRR0H = (ubrr >> 8) & 0x0F;
 	UBRR0L = ubrr & 0xFF;
+	UCSR0C = _BV(UCSZ01) | _BV(UCSZ00); // 8 data bits, no parity, 1 stop bit
 
 	UCSR0B |=  _BV(TXEN0);  // TX enabled
 	UCSR0B |=  _BV(RXEN0);  // RX enabled
-	UCSR0B &= ~_BV(UDRIE0); // Data Register Empty Interrupt disabled
+	UCSR0B &= ~_BV(UDRIE0); // Data Register Empty Interrupt disabled, put enables it
+	
+#ifdef RC_USE_UART
+	uint8_t oldSREG = SREG;
+	cli();
+	s_txHead = 0;
+	s_txTail = 0;
+	s_rxHead = 0;
+	s_rxTail = 0;
+	s_txOverflows = 0;
+	s_rxOverflows = 0;
+	s_rxErrors = 0;
+	uartint::setTxHandler(dataRegisterEmpty);
+	uartint::setRxHandler(byteReceived);
+	UCSR0B |=  _BV(RXCIE0); // Receive Complete Interrupt enabled
+	SREG = oldSREG;
+#endif // RC_USE_UART
 }
 
 
-void put(uint8_t p_byte)
+bool put(uint8_t p_byte)
 {
+#ifdef RC_USE_UART
+	uint8_t head = s_txHead;
+	uint8_t next = (head + 1) & TxMask;
+	if (next == s_txTail)
+	{
+		++s_txOverflows;
+		return false;
+	}
+	s_txBuffer[head] = p_byte;
+	memoryBarrier(); // store the byte before publishing it
+	s_txHead = next;
+	
+	uint8_t oldSREG = SREG;
+	cli();
+	UCSR0B |= _BV(UDRIE0);
+	SREG = oldSREG;
+#else
 	loop_until_bit_is_set(UCSR0A, UDRE0); // Data register empty
 	UDR0 = p_byte;
+#endif // RC_USE_UART
+	return true;
+}
+
+
+uint8_t write(const uint8_t* p_data, uint8_t p_length)
+{
+	uint8_t written = 0;
+	while (written < p_length && put(p_data[written]))
+	{
+		++written;
+	}
+#ifdef RC_USE_UART
+	// put counted the first byte that didn't fit, the rest isn't even tried so they stay in order
+	if (written < p_length)
+	{
+		s_txOverflows += p_length - written - 1;
+	}
+#endif
+	return written;
+}
+
+
+void flush()
+{
+#ifdef RC_USE_UART
+	while (s_txTail != s_txHead)
+	{
+		// the interrupt handler is emptying the buffer
+	}
+#endif
+	loop_until_bit_is_set(UCSR0A, UDRE0); // Data register empty
 }
 
 
 uint8_t get()
 {
-	loop_until_bit_is_set(UCSR0A, RXC0); // Receive complete
-	return UDR0;
+	uint8_t byte;
+	while (read(byte) == false)
+	{
+		// wait for a byte
+	}
+	return byte;
+}
+
+
+bool read(uint8_t& p_byte)
+{
+#ifdef RC_USE_UART
+	uint8_t tail = s_rxTail;
+	if (tail == s_rxHead)
+	{
+		return false;
+	}
+	memoryBarrier(); // don't read the byte before the head
+	p_byte = s_rxBuffer[tail];
+	s_rxTail = (tail + 1) & RxMask;
+	return true;
+#else
+	if (bit_is_clear(UCSR0A, RXC0)) // Receive complete
+	{
+		return false;
+	}
+	p_byte = UDR0;
+	return true;
+#endif // RC_USE_UART
+}
+
+
+uint8_t available()
+{
+#ifdef RC_USE_UART
+	return (s_rxHead - s_rxTail) & RxMask;
+#else
+	return bit_is_set(UCSR0A, RXC0) ? 1 : 0;
+#endif // RC_USE_UART
 }
 
 
+uint8_t space()
+{
+#ifdef RC_USE_UART
+	return (s_txTail - s_txHead - 1) & TxMask;
+#else
+	return bit_is_set(UCSR0A, UDRE0) ? 1 : 0;
+#endif // RC_USE_UART
+}
+
+
+uint16_t getTxOverflows()
+{
+#ifdef RC_USE_UART
+	return s_txOverflows;
+#else
+	return 0;
+#endif
+}
+
+
+uint16_t getRxOverflows()
+{
+#ifdef RC_USE_UART
+	return readCounter(s_rxOverflows);
+#else
+	return 0;
+#endif
+}
+
+
+uint16_t getRxErrors()
+{
+#ifdef RC_USE_UART
+	return readCounter(s_rxErrors);
+#else
+	return 0;
+#endif
+}
+
+
+// stdio streams only exist in avr-libc
+#ifdef _FDEV_SETUP_WRITE
+
 static int uart_putchar(char p_c, FILE* p_stream)
 {
 	put(static_cast<uint8_t>(p_c));
@@ -87,6 +306,8 @@ void setStdIn()
 	stdin = &s_stdin; 
 }
 
+#endif // _FDEV_SETUP_WRITE
+
 
 // namespace end
 }
@@ -16,9 +16,15 @@
 
 #include <inttypes.h>
 
+// include global config settings first
+#include <rc_config.h>
+
 /*!
  *  \file   rc_uart.h
  *  \brief  Basic uart communications for Atmega328p
+ *  \details With RC_USE_UART defined the uart sends from and receives into ring buffers
+ *           in its interrupt handlers, writing and reading never wait.
+ *           Without it put and get wait for the uart.
  *  \author Daniel van den Ouden
  *  \date   Nov-2012
  *  \copyright Public Domain.
@@ -30,17 +36,54 @@ namespace rc
 namespace uart
 {
 	/*! \brief Initializes uart
-		\param p_baud Baud rate.*/
-	void init(uint16_t p_baud);
+		\param p_baud Baud rate.
+		\note Uses 8 data bits, no parity, 1 stop bit. Empties the buffers and resets the counters.*/
+	void init(uint32_t p_baud);
 	
 	/*! \brief Writes one byte
-		\param p_byte byte to write.*/
-	void put(uint8_t p_byte);
+		\param p_byte byte to write.
+		\return false if the transmit buffer was full and the byte has been dropped.*/
+	bool put(uint8_t p_byte);
+	
+	/*! \brief Writes a buffer
+		\param p_data bytes to write.
+		\param p_length number of bytes to write.
+		\return Number of bytes written, the rest has been dropped.*/
+	uint8_t write(const uint8_t* p_data, uint8_t p_length);
+	
+	/*! \brief Waits until all bytes in the transmit buffer have been sent.*/
+	void flush();
 	
 	/*! \brief Reads one byte
-		\return Byte read.*/
+		\return Byte read.
+		\note Waits for a byte to arrive.*/
 	uint8_t get();
 	
+	/*! \brief Reads one byte if there is one
+		\param p_byte Byte read.
+		\return Whether a byte has been read.*/
+	bool read(uint8_t& p_byte);
+	
+	/*! \brief Gets the number of received bytes waiting to be read
+		\return Number of bytes in the receive buffer.*/
+	uint8_t available();
+	
+	/*! \brief Gets the number of bytes that can be written without any being dropped
+		\return Number of free bytes in the transmit buffer.*/
+	uint8_t space();
+	
+	/*! \brief Gets the number of bytes dropped because the transmit buffer was full
+		\return Number of bytes since init, wraps around after 65535.*/
+	uint16_t getTxOverflows();
+	
+	/*! \brief Gets the number of received bytes dropped because the receive buffer was full
+		\return Number of bytes since init, wraps around after 65535.*/
+	uint16_t getRxOverflows();
+	
+	/*! \brief Gets the number of received bytes dropped because of framing, parity or overrun errors
+		\return Number of bytes since init, wraps around after 65535.*/
+	uint16_t getRxErrors();
+	
 	/*! \brief Sets uart as stdout file*/
 	void setStdOut();
 	
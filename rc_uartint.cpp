@@ -0,0 +1,85 @@
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_uartint.cpp
+** Global UART interrupt handler
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <Arduino.h>
+
+#define RC_MODULE RC_MODULE_IO
+#include <rc_debug_lib.h>
+#include <rc_uartint.h>
+
+
+#ifdef RC_USE_UART
+
+namespace rc {
+namespace uartint {
+
+static volatile RxCallback s_rxCallback = 0; //!< Receive callback function
+static volatile void*      s_rxUserdata = 0; //!< Receive user data
+static volatile TxCallback s_txCallback = 0; //!< Data register empty callback function
+static volatile void*      s_txUserdata = 0; //!< Data register empty user data
+
+
+void setRxHandler(RxCallback p_callback, void* p_user)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	s_rxCallback = p_callback;
+	s_rxUserdata = p_user;
+	SREG = oldSREG;
+}
+
+
+void setTxHandler(TxCallback p_callback, void* p_user)
+{
+	uint8_t oldSREG = SREG;
+	cli();
+	s_txCallback = p_callback;
+	s_txUserdata = p_user;
+	SREG = oldSREG;
+}
+
+
+// namespace end
+}
+}
+
+
+// Receive complete handler
+ISR(USART_RX_vect)
+{
+	// read the status before the data, reading the data clears the status
+	uint8_t status = UCSR0A;
+	uint8_t data = UDR0;
+	if (rc::uartint::s_rxCallback)
+	{
+		rc::uartint::s_rxCallback(data, (status & (_BV(FE0) | _BV(DOR0) | _BV(UPE0))) == 0,
+		                          const_cast<void*>(rc::uartint::s_rxUserdata));
+	}
+}
+
+
+// Data register empty handler
+ISR(USART_UDRE_vect)
+{
+	if (rc::uartint::s_txCallback)
+	{
+		rc::uartint::s_txCallback(const_cast<void*>(rc::uartint::s_txUserdata));
+	}
+	else
+	{
+		// nobody to send anything, this interrupt would keep firing
+		UCSR0B &= ~_BV(UDRIE0);
+	}
+}
+
+#endif // RC_USE_UART
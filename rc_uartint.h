@@ -0,0 +1,66 @@
+#ifndef INC_RC_UARTINT_H
+#define INC_RC_UARTINT_H
+
+/* ---------------------------------------------------------------------------
+** This software is in the public domain, furnished "as is", without technical
+** support, and with no warranty, express or implied, as to its usefulness for
+** any purpose.
+**
+** rc_uartint.h
+** Global UART interrupt handler
+**
+** Author: Daniel van den Ouden
+** Project: ArduinoRCLib
+** Website: http://sourceforge.net/p/arduinorclib/
+** -------------------------------------------------------------------------*/
+
+#include <inttypes.h>
+
+// include global config settings first
+#include <rc_config.h>
+
+
+#ifdef RC_USE_UART
+
+/*!
+ *  \file      rc_uartint.h
+ *  \brief     Global UART interrupt handler.
+ *  \details   There's only one receive and one data register empty interrupt,
+ *             the classes using the UART register their handlers here.
+ *  \author    Daniel van den Ouden
+ *  \date      Oct-2026
+ *  \copyright Public Domain.
+*/
+
+namespace rc {
+namespace uartint {
+
+	/*! \brief Type definition for receive callback function
+	    \param p_byte Received byte.
+	    \param p_valid False if the UART reported a framing, parity or overrun error.
+	    \param p_user User supplied data for callback.*/
+	typedef void (*RxCallback)(uint8_t p_byte, bool p_valid, void* p_user);
+	
+	/*! \brief Type definition for data register empty callback function
+	    \param p_user User supplied data for callback.
+	    \note The callback should write UDR0, or disable the interrupt when it has nothing left to send.*/
+	typedef void (*TxCallback)(void* p_user);
+	
+	/*! \brief Sets the receive handler.
+	    \param p_callback Function to call for every received byte, 0 to remove the handler.
+	    \param p_user User supplied data.
+	    \note This does not enable the receiver or its interrupt.*/
+	void setRxHandler(RxCallback p_callback, void* p_user = 0);
+	
+	/*! \brief Sets the data register empty handler.
+	    \param p_callback Function to call when the UART can take the next byte, 0 to remove the handler.
+	    \param p_user User supplied data.
+	    \note This does not enable the transmitter or its interrupt.*/
+	void setTxHandler(TxCallback p_callback, void* p_user = 0);
+	
+} // uartint
+} // rc
+
+#endif // RC_USE_UART
+
+#endif // INC_RC_UARTINT_H
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+# ---------------------------------------------------------------------------
+# This software is in the public domain, furnished "as is", without technical
+# support, and with no warranty, express or implied, as to its usefulness for
+# any purpose.
+#
+# rc_logdecode.py
+# Decodes the binary log of rc_log.h using the elf file of the build
+#
+# Usage: rc_logdecode.py <elf file> [log file]
+# The log is read from stdin when no log file is given, so it can be piped
+# straight from the serial port, for example:
+#   stty -F /dev/ttyUSB0 raw 115200 && rc_logdecode.py sketch.elf < /dev/ttyUSB0
+#
+# Author: Daniel van den Ouden
+# Project: ArduinoRCLib
+# Website: http://sourceforge.net/p/arduinorclib/
+# ---------------------------------------------------------------------------
+
+import os
+import re
+import struct
+import sys
+
+SYNC = 0xA5
+LEVELS = {1: 'ERROR', 2: 'WARN', 3: 'INFO', 4: 'DEBUG', 5: 'TRACE'}
+
+EM_AVR = 83
+AVR_RAM = 0x800000  # data addresses of avr-gcc elf files are offset by this
+
+SHF_ALLOC = 0x2
+SHT_NOBITS = 8
+
+FORMAT = re.compile(r'%([-+ #0]*)(\d+|\*)?(?:\.(\d+|\*))?(hh|h|ll|l|L|z|j|t)?([diouxXcsSpfFeEgGaA%])')
+
+
+class Elf(object):
+	"""Reads strings from the loadable sections of an elf file."""
+
+	def __init__(self, path):
+		with open(path, 'rb') as f:
+			self.data = f.read()
+		if self.data[:4] != b'\x7fELF':
+			raise ValueError('%s is not an elf file' % path)
+		wide = self.data[4] == 2
+		self.endian = '<' if self.data[5] == 1 else '>'
+		machine = struct.unpack_from(self.endian + 'H', self.data, 18)[0]
+
+		if wide:
+			shoff, = struct.unpack_from(self.endian + 'Q', self.data, 40)
+			shentsize, shnum = struct.unpack_from(self.endian + 'HH', self.data, 58)
+			section = self.endian + 'IIQQQQ'
+		else:
+			shoff, = struct.unpack_from(self.endian + 'I', self.data, 32)
+			shentsize, shnum = struct.unpack_from(self.endian + 'HH', self.data, 46)
+			section = self.endian + 'IIIIII'
+
+		self.sections = []
+		for i in range(shnum):
+			_, kind, flags, addr, offset, size = struct.unpack_from(section, self.data, shoff + i * shentsize)
+			if flags & SHF_ALLOC and kind != SHT_NOBITS and size > 0:
+				self.sections.append((addr, offset, size))
+
+		# sizes of the arguments as they're passed to printf
+		self.avr = machine == EM_AVR
+		if self.avr:
+			self.sizes = {'int': 2, 'long': 4, 'long long': 8, 'pointer': 2, 'double': 4}
+		elif wide:
+			self.sizes = {'int': 4, 'long': 8, 'long long': 8, 'pointer': 8, 'double': 8}
+		else:
+			self.sizes = {'int': 4, 'long': 4, 'long long': 8, 'pointer': 4, 'double': 8}
+
+	def string(self, address, ram=False):
+		"""Gets the string at an address in program space, or in ram, None if it can't be found."""
+		if ram and self.avr:
+			address += AVR_RAM
+		for addr, offset, size in self.sections:
+			if addr <= address < addr + size:
+				start = offset + address - addr
+				end = self.data.find(b'\0', start, offset + size)
+				if end < 0:
+					return None
+				return self.data[start:end].decode('latin-1')
+		return None
+
+
+class Decoder(object):
+	"""Turns a stream of log bytes into lines of text."""
+
+	def __init__(self, elf):
+		self.elf = elf
+		self.pointer = elf.sizes['pointer']
+		self.header = 5 + 2 * self.pointer
+		self.buffer = bytearray()
+
+	def feed(self, data):
+		"""Adds bytes to the stream, returns the lines of all complete records."""
+		self.buffer += data
+		lines = []
+		while True:
+			start = self.buffer.find(bytes([SYNC]))
+			if start < 0:
+				del self.buffer[:]
+				break
+			del self.buffer[:start]
+			if len(self.buffer) < self.header:
+				break
+			if self.strings(self.buffer) is None:
+				# not a record, don't wait for the arguments of a bogus header
+				del self.buffer[:1]
+				continue
+			size = self.buffer[2]
+			if len(self.buffer) < self.header + size:
+				break
+			line = self.decode(bytes(self.buffer[:self.header + size]))
+			if line is None:
+				# not a record, look for the next sync byte
+				del self.buffer[:1]
+				continue
+			lines.append(line)
+			del self.buffer[:self.header + size]
+		return lines
+
+	def strings(self, record):
+		"""Gets the level, file name and format string of a record, None if the header isn't valid."""
+		level = LEVELS.get(record[1])
+		file_name = self.elf.string(self.unsigned(record[5:5 + self.pointer]))
+		fmt = self.elf.string(self.unsigned(record[5 + self.pointer:self.header]))
+		if level is None or file_name is None or fmt is None:
+			return None
+		return level, file_name, fmt
+
+	def decode(self, record):
+		level, file_name, fmt = self.strings(record)
+		line, = struct.unpack_from('<H', record, 3)
+		try:
+			message = self.format(fmt, record[self.header:])
+		except ValueError:
+			return None
+		return '[%s] %s:%d: %s' % (level, file_name, line, message)
+
+	def unsigned(self, data):
+		return int.from_bytes(data, 'little')
+
+	def signed(self, data):
+		return int.from_bytes(data, 'little', signed=True)
+
+	def format(self, fmt, args):
+		"""Formats the arguments like printf, raises ValueError if they don't match the format."""
+		result = []
+		pos = 0
+		end = 0
+		for match in FORMAT.finditer(fmt):
+			result.append(fmt[end:match.start()])
+			end = match.end()
+			flags, width, precision, length, conversion = match.groups()
+			if conversion == '%':
+				result.append('%')
+				continue
+
+			def take(size):
+				nonlocal pos
+				if pos + size > len(args):
+					raise ValueError('not enough arguments')
+				data = args[pos:pos + size]
+				pos += size
+				return data
+
+			if width == '*':
+				width = str(self.signed(take(self.elf.sizes['int'])))
+			if precision == '*':
+				precision = str(self.signed(take(self.elf.sizes['int'])))
+			spec = '%' + flags + (width or '') + ('.' + precision if precision is not None else '')
+
+			if conversion in 'di':
+				value = self.signed(take(self.integer(length)))
+				result.append((spec + 'd') % value)
+			elif conversion in 'ouxX':
+				value = self.unsigned(take(self.integer(length)))
+				result.append((spec + conversion) % value)
+			elif conversion == 'c':
+				value = self.unsigned(take(self.elf.sizes['int'])) & 0xFF
+				result.append((spec + 'c') % chr(value))
+			elif conversion in 'sS':
+				address = self.unsigned(take(self.pointer))
+				text = self.elf.string(address, ram=conversion == 's')
+				if text is None:
+					text = '<0x%x>' % address
+				result.append((spec + 's') % text)
+			elif conversion == 'p':
+				result.append('0x%x' % self.unsigned(take(self.pointer)))
+			else:
+				size = self.elf.sizes['double']
+				value, = struct.unpack('<f' if size == 4 else '<d', take(size))
+				result.append((spec + conversion.replace('a', 'e').replace('A', 'E')) % value)
+		result.append(fmt[end:])
+		if pos != len(args):
+			raise ValueError('too many arguments')
+		return ''.join(result)
+
+	def integer(self, length):
+		if length == 'll':
+			return self.elf.sizes['long long']
+		if length in ('l', 'z', 'j', 't'):
+			return self.elf.sizes['long']
+		return self.elf.sizes['int']
+
+
+def main(argv):
+	if len(argv) not in (2, 3):
+		sys.stderr.write('usage: %s <elf file> [log file]\n' % os.path.basename(argv[0]))
+		return 2
+	decoder = Decoder(Elf(argv[1]))
+	stream = open(argv[2], 'rb') if len(argv) == 3 else sys.stdin.buffer
+	fd = stream.fileno()
+	while True:
+		# read whatever has arrived, so a live serial port is decoded as it comes in
+		data = os.read(fd, 4096)
+		if not data:
+			break
+		for line in decoder.feed(data):
+			print(line)
+		sys.stdout.flush()
+	return 0
+
+
+if __name__ == '__main__':
+	sys.exit(main(sys.argv))
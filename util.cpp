@@ -11,6 +11,7 @@
 ** Website: http://sourceforge.net/p/arduinorclib/
 ** -------------------------------------------------------------------------*/
 
+#define RC_MODULE RC_MODULE_MIXER
 #include <rc_debug_lib.h>
 #include <util.h>
 
@@ -21,14 +22,32 @@ namespace rc
 static uint16_t s_center = 1520;
 static uint16_t s_travel = 600;
 
+// Precalculated by setCenter and setTravel, so the conversions don't need to
+static uint16_t s_min   = 920;    //!< s_center - s_travel
+static uint16_t s_max   = 2120;   //!< s_center + s_travel
+static uint16_t s_range = 1200;   //!< s_travel * 2
+static uint32_t s_scale = 111849; //!< 2^24 / (s_travel / 4), rounded up
+
+
+static void updateLimits()
+{
+	s_min   = s_center - s_travel;
+	s_max   = s_center + s_travel;
+	s_range = s_travel << 1;
+	
+	uint16_t quarter = s_travel >> 2;
+	s_scale = quarter == 0 ? 0 : ((1UL << 24) + quarter - 1) / quarter;
+}
+
+
 int16_t microsToNormalized(uint16_t p_micros)
 {
 	// first we clip values, early abort.
-	if (p_micros >= s_center + s_travel)
+	if (p_micros >= s_max)
 	{
 		return 256;
 	}
-	else if (p_micros <= s_center - s_travel)
+	else if (p_micros <= s_min)
 	{
 		return -256;
 	}
@@ -43,8 +62,10 @@ int16_t microsToNormalized(uint16_t p_micros)
 	// So instead of multiplying with 256 and dividing by s_travel,
 	// we multiply by 64 and divide by s_travel / 4
 	// we lose the last two bits of the division, but that's not going to make much of a difference...
-	delta <<= 6;
-	delta /= (s_travel >> 2);
+	// Dividing is slow, so we multiply by the reciprocal of s_travel / 4 in 2^24 units and divide by 2^18.
+	// Because it's rounded up the result is exactly (delta * 64) / (s_travel / 4) for travels up to 1024,
+	// for larger travels the result is still correct where (delta * 64) would have overflowed.
+	delta = static_cast<uint16_t>((delta * s_scale) >> 18);
 	
 	return (p_micros >= s_center) ? delta : -delta;
 }
@@ -59,8 +80,8 @@ uint16_t normalizedToMicros(int16_t p_normal)
 	// this needs to be done in multiple stages to prevent overflows while keeping maximum resolution
 	p_normal += 256; // first we bring it up to [0 - 512]
 	
-	// calculate range
-	uint16_t range = s_travel << 1;
+	// range is s_travel * 2
+	uint16_t range = s_range;
 	
 	// we assume the range won't be more than 2000 microseconds, 2 milliseconds
 	// this means we have 5 bits of room to play with
@@ -83,7 +104,115 @@ uint16_t normalizedToMicros(int16_t p_normal)
 	p2 >>= 4; // divide by 16; ( / 512) << 5
 	
 	// piece it back together, offset with center
-	return ((s_center - s_travel) + p1 + p2);
+	return (s_min + p1 + p2);
+}
+
+
+// The buffer versions give the same results as the single value versions,
+// but have no early aborts so the compiler can vectorize them on the host.
+
+void microsToNormalized(const uint16_t* p_micros, int16_t* p_normal, uint8_t p_count)
+{
+	// copy to locals so they don't have to be reloaded after every store
+	const uint16_t center = s_center;
+	const uint16_t min    = s_min;
+	const uint16_t max    = s_max;
+	const uint32_t scale  = s_scale;
+	
+	for (uint8_t i = 0; i < p_count; ++i)
+	{
+		uint16_t micros = p_micros[i];
+		uint16_t delta = (micros > center) ? (micros - center) : (center - micros);
+		int16_t value = static_cast<int16_t>((delta * scale) >> 18);
+		value = (micros >= center) ? value : -value;
+		p_normal[i] = (micros >= max) ? 256 : ((micros <= min) ? -256 : value);
+	}
+}
+
+
+void normalizedToMicros(const int16_t* p_normal, uint16_t* p_micros, uint8_t p_count)
+{
+	const uint16_t min   = s_min;
+	const uint16_t range = s_range;
+	
+	for (uint8_t i = 0; i < p_count; ++i)
+	{
+		RC_ASSERT_MINMAX(p_normal[i], -256, 256);
+		
+		// see normalizedToMicros(int16_t)
+		uint16_t normal = static_cast<uint16_t>(p_normal[i] + 256);
+		uint16_t p1 = static_cast<uint16_t>(( normal       & 0x1F) * range) >> 9;
+		uint16_t p2 = static_cast<uint16_t>(((normal >> 5) & 0x1F) * range) >> 4;
+		p_micros[i] = min + p1 + p2;
+	}
+}
+
+
+void ticksToMicros(const uint16_t* p_ticks, uint16_t* p_micros, uint8_t p_count)
+{
+	for (uint8_t i = 0; i < p_count; ++i)
+	{
+		p_micros[i] = p_ticks[i] >> 1;
+	}
+}
+
+
+void microsToTicks(const uint16_t* p_micros, uint16_t* p_ticks, uint8_t p_count)
+{
+	for (uint8_t i = 0; i < p_count; ++i)
+	{
+		p_ticks[i] = p_micros[i] << 1;
+	}
+}
+
+
+void microsToPacked(const uint16_t* p_micros, uint8_t p_count, uint8_t* p_packed)
+{
+	RC_ASSERT_MINMAX(p_count, 0, 16);
+	
+	uint32_t bits = 0;
+	uint8_t  bitCount = 0;
+	for (uint8_t i = 0; i < 16; ++i)
+	{
+		// (us - 880) * 1.6 rounded up, 992 (1500 us) for channels we don't have
+		uint16_t value = 992;
+		if (i < p_count)
+		{
+			uint16_t us = p_micros[i] < 880 ? 880 : p_micros[i];
+			uint32_t scaled = ((static_cast<uint32_t>(us - 880) * 8 + 4) * 13108UL) >> 16;
+			value = scaled > 2047 ? 2047 : static_cast<uint16_t>(scaled);
+		}
+		bits |= static_cast<uint32_t>(value) << bitCount;
+		bitCount += 11;
+		while (bitCount >= 8)
+		{
+			*p_packed = bits & 0xFF;
+			++p_packed;
+			bits >>= 8;
+			bitCount -= 8;
+		}
+	}
+}
+
+
+void packedToMicros(const uint8_t* p_packed, uint16_t* p_micros, uint8_t p_count)
+{
+	RC_ASSERT_MINMAX(p_count, 0, 16);
+	
+	uint32_t bits = 0;
+	uint8_t  bitCount = 0;
+	for (uint8_t i = 0; i < p_count; ++i)
+	{
+		while (bitCount < 11)
+		{
+			bits |= static_cast<uint32_t>(*p_packed) << bitCount;
+			++p_packed;
+			bitCount += 8;
+		}
+		p_micros[i] = ((static_cast<uint16_t>(bits & 0x07FF) * 5) >> 3) + 880;
+		bits >>= 11;
+		bitCount -= 11;
+	}
 }
 
 
@@ -180,6 +309,7 @@ void setCenter(uint16_t p_center)
 	RC_ASSERT(p_center >= getTravel());
 	
 	s_center = p_center;
+	updateLimits();
 }
 
 
@@ -196,6 +326,7 @@ void setTravel(uint16_t p_travel)
 	RC_ASSERT(p_travel <= getCenter());
 	
 	s_travel = p_travel;
+	updateLimits();
 }
 
 
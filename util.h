@@ -36,6 +36,44 @@ namespace rc
 	    \return Microseconds.*/
 	uint16_t normalizedToMicros(int16_t p_normal);
 	
+	/*! \brief convert a buffer of microseconds to normalized values [-256 - 256].
+	    \param p_micros Input in microseconds.
+	    \param p_normal Output buffer for normalized values, range [-256 - 256], may be the same as p_micros.
+	    \param p_count Number of values to convert.*/
+	void microsToNormalized(const uint16_t* p_micros, int16_t* p_normal, uint8_t p_count);
+	
+	/*! \brief convert a buffer of normalized values [-256 - 256] to microseconds.
+	    \param p_normal Normalized values, range [-256 - 256].
+	    \param p_micros Output buffer for microseconds, may be the same as p_normal.
+	    \param p_count Number of values to convert.*/
+	void normalizedToMicros(const int16_t* p_normal, uint16_t* p_micros, uint8_t p_count);
+	
+	/*! \brief convert a buffer of Timer1 ticks (0.5 microseconds) to microseconds.
+	    \param p_ticks Input in Timer1 ticks.
+	    \param p_micros Output buffer for microseconds, may be the same as p_ticks.
+	    \param p_count Number of values to convert.*/
+	void ticksToMicros(const uint16_t* p_ticks, uint16_t* p_micros, uint8_t p_count);
+	
+	/*! \brief convert a buffer of microseconds to Timer1 ticks (0.5 microseconds).
+	    \param p_micros Input in microseconds, range [0 - 32767].
+	    \param p_ticks Output buffer for Timer1 ticks, may be the same as p_micros.
+	    \param p_count Number of values to convert.*/
+	void microsToTicks(const uint16_t* p_micros, uint16_t* p_ticks, uint8_t p_count);
+	
+	/*! \brief convert a buffer of microseconds to packed 11 bit values, the channel format of SBUS and CRSF.
+	    \param p_micros Input in microseconds, range [880 - 2159], values outside the range are clipped.
+	    \param p_count Number of values in p_micros, range [0 - 16], the remaining channels are centered.
+	    \param p_packed Output buffer of 22 bytes, 16 values of 11 bits, least significant bit first.
+	    \note Rounds up, so packedToMicros gives back the same microseconds.*/
+	void microsToPacked(const uint16_t* p_micros, uint8_t p_count, uint8_t* p_packed);
+	
+	/*! \brief convert packed 11 bit values, the channel format of SBUS and CRSF, to microseconds.
+	    \param p_packed Input of 22 bytes, 16 values of 11 bits, least significant bit first.
+	    \param p_micros Output buffer for microseconds, range [880 - 2159].
+	    \param p_count Number of values to convert, range [0 - 16].
+	    \note 172 - 1811 maps to 987 - 2011 microseconds, 992 is center at 1500 microseconds.*/
+	void packedToMicros(const uint8_t* p_packed, uint16_t* p_micros, uint8_t p_count);
+	
 	/*! \brief convert a certain range to a normalized value [-256 - 256].
 	    \param p_value Value within range [0 - p_range].
 	    \param p_range Max value in the range [1 - 65535].
@@ -85,6 +123,14 @@ namespace rc
 	
 	/*! \brief Sets timings according to JR standards, center 1500, travel 600.*/
 	void loadJR();
+	
+	/*! \brief Keeps the compiler from moving memory accesses across this point.
+	    \details Use this between filling a buffer and publishing it through a volatile
+	              index when the buffer is shared with an interrupt routine.*/
+	inline void memoryBarrier()
+	{
+		__asm__ __volatile__ ("" ::: "memory");
+	}
 }
 
 #endif // INC_RC_UTIL_H